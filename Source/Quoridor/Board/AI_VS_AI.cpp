@@ -1,5 +1,6 @@
 ﻿#include "AI_VS_AI.h"
 #include "MinimaxEngine.h"
+#include "MinimaxSearchWorker.h"
 #include "Quoridor/Board/QuoridorBoard.h"
 #include "Quoridor/Pawn/QuoridorPawn.h"
 #include "Kismet/GameplayStatics.h"
@@ -8,18 +9,38 @@
 #include "Engine/World.h"
 #include "Engine/Engine.h"
 
+static FString GetAlgorithmDisplayName(int32 algo)
+{
+    switch (algo)
+    {
+    case 1:
+        return TEXT("Plain Minimax");
+    case 2:
+        return TEXT("Minimax Parallel");
+    case 3:
+        return TEXT("Minimax Alpha Beta");
+    case 4:
+        return TEXT("Parallel Minimax Alpha-Beta");
+    default:
+        return TEXT("Unknown AI");
+    }
+}
+
 AAI_VS_AI::AAI_VS_AI()
 {
-    // Enable ticking on this AI board if you plan to do per-frame logic
+    // AI turns are driven by OnTurnChanged / OnBoardReady, so no per-frame logic by default
     PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.bStartWithTickEnabled = false;
 }
 void AAI_VS_AI::BeginPlay()
 {
     Super::BeginPlay();
 
-    // Tick stays enabled, we use ElapsedTime to wait before acting
-    ElapsedTime = 0.0f;
-    bDelayPassed = false;
+    // AI logic waits for OnBoardReady instead of a fixed delay, then follows OnTurnChanged
+    bDelayPassed = IsBoardReady();
+    OnBoardReady.AddDynamic(this, &AAI_VS_AI::HandleBoardReady);
+    OnTurnChanged.AddDynamic(this, &AAI_VS_AI::HandleTurnChanged);
+    TimeManager.Reset(TimeControlBaseSeconds, TimeControlIncrementSeconds);
     
     // Randomly choose which AI will be Player 1 or Player 2
 
@@ -37,25 +58,37 @@ void AAI_VS_AI::BeginPlay()
     }
 }
 
-void AAI_VS_AI::Tick(float DeltaTime)
+void AAI_VS_AI::HandleBoardReady(AQuoridorBoard* Board)
+{
+    bDelayPassed = true;
+    UE_LOG(LogTemp, Warning, TEXT("Board ready, starting AI..."));
+    TryStartAITurn();
+}
+
+void AAI_VS_AI::HandleTurnChanged(int32 NewPlayerTurn, int32 NewTurnCount)
 {
-    Super::Tick(DeltaTime);
+    // Next tick: the async callback that ended the previous turn still clears bMinimaxInProgress after ExecuteAction
+    GetWorldTimerManager().SetTimerForNextTick(this, &AAI_VS_AI::TryStartAITurn);
+}
 
-    GEngine->AddOnScreenDebugMessage(1, 0.0f, FColor::Cyan,
-        FString::Printf(TEXT("Turn: Player %d"), CurrentPlayerTurn));
+void AAI_VS_AI::TryStartAITurn()
+{
+    // Wait for the board (tiles, connections, pawns) and stop once the game is over
+    if (!bDelayPassed || bIsGameFinished)
+        return;
 
-    // Wait a bit before AI logic kicks in
-    if (!bDelayPassed)
+    // Fast-forward: satu segment mencakup kedua AI, jadi tidak perlu dibedakan per pemain
+    if (bFastForward)
     {
-        ElapsedTime += DeltaTime;
-        if (ElapsedTime < 5.0f)
-            return;
-
-        bDelayPassed = true;
-        UE_LOG(LogTemp, Warning, TEXT("AI logic delay passed, starting AI..."));
+        if (!bIsAITurnRunning && !bMinimaxInProgress)
+        {
+            bIsAITurnRunning = true;
+            RunFastForwardSegment();
+        }
+        return;
     }
     
-    if (bDelayPassed && CurrentPlayerTurn == AI1Player && !bIsAITurnRunning)
+    if (CurrentPlayerTurn == AI1Player && !bIsAITurnRunning)
     {
         AQuoridorPawn* P = GetPawnForPlayer(CurrentPlayerTurn);
         if (P && P->GetTile())
@@ -68,7 +101,7 @@ void AAI_VS_AI::Tick(float DeltaTime)
             UE_LOG(LogTemp, Warning, TEXT("AI pawn not ready yet"));
         }
     }
-    if (bDelayPassed && CurrentPlayerTurn == AI2Player && !bIsAITurnRunning)
+    if (CurrentPlayerTurn == AI2Player && !bIsAITurnRunning)
     {
         AQuoridorPawn* P = GetPawnForPlayer(CurrentPlayerTurn);
         if (P && P->GetTile())
@@ -86,25 +119,7 @@ void AAI_VS_AI::Tick(float DeltaTime)
 // Parallel
 void AAI_VS_AI::RunMinimax(int32 Player, int32 algo)
 {
-    FString SelectedAIType;
-    switch (algo)
-    {
-    case 1:
-        SelectedAIType = TEXT("Plain Minimax");
-        break;
-    case 2:
-        SelectedAIType = TEXT("Minimax Parallel");
-        break;
-    case 3:
-        SelectedAIType = TEXT("Minimax Alpha Beta");
-        break;  
-    case 4:
-        SelectedAIType = TEXT("Parallel Minimax Alpha-Beta");
-        break;
-    default:
-        SelectedAIType = TEXT("Unknown AI");
-        break;
-    }
+    FString SelectedAIType = GetAlgorithmDisplayName(algo);
 
     if (Player == 1)
     {
@@ -130,6 +145,13 @@ void AAI_VS_AI::RunMinimax(int32 Player, int32 algo)
         DelayHandle,
         [this, AIPlayer, Choice]()
         {
+            // Game bisa selesai selama delay; jangan mulai search yang hasilnya dibuang
+            if (bIsGameFinished)
+            {
+                bMinimaxInProgress = false;
+                return;
+            }
+
             if (AIPlayer == 1)
                 ThinkingStartTimeP1 = FPlatformTime::Seconds();
             else if (AIPlayer == 2)
@@ -138,64 +160,210 @@ void AAI_VS_AI::RunMinimax(int32 Player, int32 algo)
             FMinimaxState StateSnapshot = FMinimaxState::FromBoard(this);
             int32 defaultDepth = Depth;
 
-            // Run the actual minimax on a background thread
-            Async(EAsyncExecution::Thread, [this, StateSnapshot, defaultDepth, AIPlayer,Choice]()
+            // Run the actual minimax on the board's persistent search worker
+            FMinimaxSearchJob Job;
+            Job.Engine = GetSearchEngine(AIPlayer);
+            Job.GameId = GameId;
+            Job.TurnIndex = TurnCount;
+            Job.State = StateSnapshot;
+            Job.Depth = defaultDepth;
+            Job.PlayerTurn = AIPlayer;
+            Job.AlgorithmChoice = Choice;
+
+            // Time control: Depth jadi batas atas iterative deepening, budget langkah ditegakkan lewat deadline
+            if (TimeManager.IsEnabled())
+            {
+                const double Budget = TimeManager.AllocateMoveBudget(AIPlayer, StateSnapshot);
+                Job.bIterativeDeepening = true;
+                Job.StopToken = MakeShared<FMinimaxStopToken>();
+                Job.StopToken->SetDeadline(FPlatformTime::Seconds() + Budget);
+                UE_LOG(LogTemp, Log, TEXT("[TimeControl] P%d budget %.3f s | clock %.3f s"),
+                    AIPlayer, Budget, TimeManager.GetRemainingSeconds(AIPlayer));
+            }
+
+            // Once the worker finishes, come back to GameThread to execute the move
+            TWeakObjectPtr<AAI_VS_AI> WeakThis(this);
+            Job.OnCompleteGameThread = [this, WeakThis, AIPlayer](const FMinimaxResult& Action)
             {
-                FMinimaxResult Action = MinimaxEngine::RunSelectedAlgorithm(StateSnapshot,defaultDepth,AIPlayer,Choice);
+                if (!WeakThis.IsValid())
+                    return;
+
+                double EndTime = FPlatformTime::Seconds();
+                double Elapsed = 0.0;
 
-                // Once SolveParallel finishes, come back to GameThread to execute the move
-                AsyncTask(ENamedThreads::GameThread, [this, Action, AIPlayer]()
+                if (AIPlayer == 1)
+                {
+                    Elapsed = EndTime - ThinkingStartTimeP1;
+                    TotalThinkingTimeP1 += Elapsed;
+                    UE_LOG(LogTemp, Warning, TEXT("[AI P1] Thinking Time: %.4f s | Total: %.4f s"), Elapsed, TotalThinkingTimeP1);
+                }
+                else if (AIPlayer == 2)
                 {
-                    double EndTime = FPlatformTime::Seconds();
-                    double Elapsed = 0.0;
-
-                    if (AIPlayer == 1)
-                    {
-                        Elapsed = EndTime - ThinkingStartTimeP1;
-                        TotalThinkingTimeP1 += Elapsed;
-                        UE_LOG(LogTemp, Warning, TEXT("[AI P1] Thinking Time: %.4f s | Total: %.4f s"), Elapsed, TotalThinkingTimeP1);
-                    }
-                    else if (AIPlayer == 2)
-                    {
-                        
-                        Elapsed = EndTime - ThinkingStartTimeP2;
-                        TotalThinkingTimeP2 += Elapsed;
-                        UE_LOG(LogTemp, Warning, TEXT("[AI P2] Thinking Time: %.4f s | Total: %.4f s"), Elapsed, TotalThinkingTimeP2);
-                    }
-                    const FMinimaxAction& BestAct = Action.BestAction;
-                    ExecuteAction(BestAct);
-
-                    // Swap turn after action is done
-                    // CurrentPlayerTurn = (AIPlayer == 1) ? 2 : 1;
-                    // SelectedPawn = GetPawnForPlayer(CurrentPlayerTurn);
-                    bMinimaxInProgress = false;
-
-                    // 4) Log detail aksi dan skor:
-                    if (BestAct.bIsWall)
-                    {
-                        UE_LOG(LogTemp, Warning,
-                            TEXT("=> Engine chose: Wall @(%d,%d) %s (score=%d)"),
-                            BestAct.SlotX,
-                            BestAct.SlotY,
-                            BestAct.bHorizontal ? TEXT("H") : TEXT("V"),
-                            Action.BestValue);
-                    }
-                    else
-                    {
-                        UE_LOG(LogTemp, Warning,
-                            TEXT("=> Engine chose: Move to (%d,%d) (score=%d)"),
-                            BestAct.MoveX,
-                            BestAct.MoveY,
-                            Action.BestValue);
-                    }
-                });
-            });
+                    
+                    Elapsed = EndTime - ThinkingStartTimeP2;
+                    TotalThinkingTimeP2 += Elapsed;
+                    UE_LOG(LogTemp, Warning, TEXT("[AI P2] Thinking Time: %.4f s | Total: %.4f s"), Elapsed, TotalThinkingTimeP2);
+                }
+                TimeManager.FinishMove(AIPlayer, Elapsed, Action.BestValue);
+                const FMinimaxAction& BestAct = Action.BestAction;
+                ExecuteAction(BestAct);
+
+                // Swap turn after action is done
+                // CurrentPlayerTurn = (AIPlayer == 1) ? 2 : 1;
+                // SelectedPawn = GetPawnForPlayer(CurrentPlayerTurn);
+                bMinimaxInProgress = false;
+
+                // 4) Log detail aksi dan skor:
+                if (BestAct.bIsWall)
+                {
+                    UE_LOG(LogTemp, Warning,
+                        TEXT("=> Engine chose: Wall @(%d,%d) %s (score=%d)"),
+                        BestAct.SlotX,
+                        BestAct.SlotY,
+                        BestAct.bHorizontal ? TEXT("H") : TEXT("V"),
+                        Action.BestValue);
+                }
+                else
+                {
+                    UE_LOG(LogTemp, Warning,
+                        TEXT("=> Engine chose: Move to (%d,%d) (score=%d)"),
+                        BestAct.MoveX,
+                        BestAct.MoveY,
+                        Action.BestValue);
+                }
+            };
+            GetSearchWorker().Enqueue(MoveTemp(Job));
         },
         2.0f,    // Delay in seconds
         false    // Do not loop
     );
 }
 
+//-----------------------------------------------------------------------------
+// Fast-forward: giliran dirantai di search worker, board disinkronkan per segment
+//-----------------------------------------------------------------------------
+void AAI_VS_AI::RunFastForwardSegment()
+{
+    bMinimaxInProgress = true;
+
+    AITypeName1 = GetAlgorithmDisplayName(AI1Player == 1 ? AI1_AlgorithmChoice : AI2_AlgorithmChoice);
+    AITypeName2 = GetAlgorithmDisplayName(AI1Player == 2 ? AI1_AlgorithmChoice : AI2_AlgorithmChoice);
+
+    const FMinimaxState Start = FMinimaxState::FromBoard(this);
+    const int32 FirstPlayer = CurrentPlayerTurn;
+    const int32 Plies = FMath::Max(1, FastForwardSyncPlies);
+    const int32 SearchDepth = Depth;
+    const int32 Choice1 = (AI1Player == 1) ? AI1_AlgorithmChoice : AI2_AlgorithmChoice;
+    const int32 Choice2 = (AI1Player == 2) ? AI1_AlgorithmChoice : AI2_AlgorithmChoice;
+    const FMinimaxTimeManager ClockBefore = TimeManager;
+    const TSharedPtr<MinimaxEngine> Engine1 = GetSearchEngine(1);
+    const TSharedPtr<MinimaxEngine> Engine2 = GetSearchEngine(2);
+
+    // Task jalan di thread pool: hanya menyentuh data yang di-capture by value, board hanya lewat WeakThis di game thread
+    TWeakObjectPtr<AAI_VS_AI> WeakThis(this);
+    FMinimaxSearchJob Job;
+    Job.Task = [WeakThis, Start, FirstPlayer, Plies, SearchDepth, Choice1, Choice2, ClockBefore, Engine1, Engine2, GameId = GameId, FirstTurn = TurnCount](const FMinimaxStopToken& Stop, int32 SearchThreadCap)
+    {
+        Engine1->BeginGame(GameId);
+        Engine2->BeginGame(GameId);
+        Engine1->MaxSearchThreads = SearchThreadCap;
+        Engine2->MaxSearchThreads = SearchThreadCap;
+
+        FMinimaxState S = Start;
+        FMinimaxTimeManager Clock = ClockBefore;
+        TArray<FMinimaxChainedMove> Moves;
+        int32 Player = FirstPlayer;
+
+        for (int32 Ply = 0; Ply < Plies; ++Ply)
+        {
+            const int32 Choice = (Player == 1) ? Choice1 : Choice2;
+            MinimaxEngine& Engine = (Player == 1) ? *Engine1 : *Engine2;
+            Engine.BeginTurn(FirstTurn + Ply);
+            const double StartTime = FPlatformTime::Seconds();
+
+            FMinimaxChainedMove& Move = Moves.AddDefaulted_GetRef();
+            Move.Player = Player;
+            if (Clock.IsEnabled())
+            {
+                FMinimaxStopToken MoveToken;
+                MoveToken.SetParent(&Stop);
+                MoveToken.SetDeadline(StartTime + Clock.AllocateMoveBudget(Player, S));
+                Move.Result = Engine.RunIterativeDeepening(S, SearchDepth, Player, Choice, &MoveToken);
+            }
+            else
+            {
+                Move.Result = Engine.RunSelectedAlgorithm(S, SearchDepth, Player, Choice, &Stop);
+            }
+
+            if (Stop.IsCancelled())
+                return;
+
+            Move.ThinkSeconds = FPlatformTime::Seconds() - StartTime;
+            Clock.FinishMove(Player, Move.ThinkSeconds, Move.Result.BestValue);
+
+            const FMinimaxAction& Act = Move.Result.BestAction;
+            if (Act.bIsWall)
+            {
+                FWallData W{ Act.SlotX, Act.SlotY, Act.WallLength, Act.bHorizontal };
+                MinimaxEngine::ApplyWall(S, Player, W);
+            }
+            else if (Act.MoveX >= 0 && Act.MoveY >= 0)
+            {
+                MinimaxEngine::ApplyPawnMove(S, Player, Act.MoveX, Act.MoveY);
+            }
+
+            // Pion sampai goal: sisa segment tidak perlu dicari
+            if (S.PawnY[0] == 8 || S.PawnY[1] == 0)
+                break;
+
+            Player = 3 - Player;
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Moves = MoveTemp(Moves), Clock]()
+        {
+            if (AAI_VS_AI* Self = WeakThis.Get())
+            {
+                Self->ApplyFastForwardSegment(Moves, Clock);
+            }
+        });
+    };
+    GetSearchWorker().Enqueue(MoveTemp(Job));
+}
+
+void AAI_VS_AI::ApplyFastForwardSegment(const TArray<FMinimaxChainedMove>& Moves, const FMinimaxTimeManager& ClockAfter)
+{
+    SetPresentationDeferred(true);
+
+    // Replay lewat ExecuteAction supaya model, pion, inventory wall, EndTurn dan HandleWin tetap satu jalur
+    int32 Applied = 0;
+    for (const FMinimaxChainedMove& Move : Moves)
+    {
+        if (bIsGameFinished || CurrentPlayerTurn != Move.Player)
+            break;
+
+        if (Move.Player == 1)
+            TotalThinkingTimeP1 += Move.ThinkSeconds;
+        else
+            TotalThinkingTimeP2 += Move.ThinkSeconds;
+
+        ExecuteAction(Move.Result.BestAction);
+        ++Applied;
+    }
+    TimeManager = ClockAfter;
+
+    SetPresentationDeferred(false);
+    FlushDeferredPresentation();
+    bMinimaxInProgress = false;
+
+    UE_LOG(LogTemp, Log, TEXT("[FastForward] Synced %d/%d plies | Turn %d | Think P1 %.3f s P2 %.3f s"),
+        Applied, Moves.Num(), TurnCount, TotalThinkingTimeP1, TotalThinkingTimeP2);
+}
+
+float AAI_VS_AI::GetRemainingClockForPlayer(int32 PlayerNum) const
+{
+    return static_cast<float>(TimeManager.GetRemainingSeconds(PlayerNum));
+}
+
 float AAI_VS_AI::GetTotalThinkingTimeForPlayer(int32 PlayerNum) const
 {
     if (PlayerNum == 1)
@@ -209,9 +377,8 @@ float AAI_VS_AI::GetTotalThinkingTimeForPlayer(int32 PlayerNum) const
 bool AAI_VS_AI::ForcePlaceWallForAI(int32 SlotX, int32 SlotY, int32 Length, bool bHorizontal)
 {
     EWallOrientation Orientation = bHorizontal ? EWallOrientation::Horizontal : EWallOrientation::Vertical;
-    AWallSlot* StartSlot = FindWallSlotAt(SlotX, SlotY, Orientation);
     
-    if (!StartSlot || Length <= 0)
+    if (!IsWallSlotInBounds(SlotX, SlotY, Orientation) || Length <= 0)
     {
         UE_LOG(LogTemp, Error, TEXT("[ForcePlaceWallForAI] Invalid StartSlot or Length=0"));
         return false;
@@ -220,67 +387,26 @@ bool AAI_VS_AI::ForcePlaceWallForAI(int32 SlotX, int32 SlotY, int32 Length, bool
     PendingWallLength = Length;
     PendingWallOrientation = Orientation;
 
-    // Gather affected slots
-    TArray<AWallSlot*> AffectedSlots;
-    AffectedSlots.Add(StartSlot);
-
+    // Validate every segment against the grid
     for (int i = 1; i < Length; ++i)
     {
         int32 NextX = SlotX + (bHorizontal ? i : 0);
         int32 NextY = SlotY + (bHorizontal ? 0 : i);
-        AWallSlot* NextSlot = FindWallSlotAt(NextX, NextY, Orientation);
 
-        if (!NextSlot)
+        if (!IsWallSlotInBounds(NextX, NextY, Orientation))
         {
             UE_LOG(LogTemp, Error, TEXT("[ForcePlaceWallForAI] Slot (%d,%d) [%s] not found"),
                 NextX, NextY, *UEnum::GetValueAsString(Orientation));
             return false;
         }
-
-        AffectedSlots.Add(NextSlot);
     }
-    
 
-    // Mark slots as occupied
-    for (AWallSlot* Slot : AffectedSlots)
-    {
-        Slot->SetOccupied(true);
-        UE_LOG(LogTemp, Warning, TEXT("Wall segment marked occupied at (%d,%d) [%s]"),
-            Slot->GridX, Slot->GridY, *UEnum::GetValueAsString(Orientation));
-    }
-    
-    if (WallClickSound)
-    {
-        UGameplayStatics::PlaySound2D(this, WallClickSound);
-    }
+    // Board model, legacy slots, visual segments and the AI's wall resource
+    CommitWallPlacement(SlotX, SlotY, Orientation, Length, CurrentPlayerTurn);
 
-    // Spawn visual wall mesh segments
-    FVector BaseLocation = StartSlot->GetActorLocation();
-    FRotator WallRotation = bHorizontal ? FRotator::ZeroRotator : FRotator(0, 90, 0);
-
-    for (int i = 0; i < Length; ++i)
-    {
-        FVector SegmentLocation = BaseLocation + (bHorizontal
-            ? FVector(i * TileSize, 0, 0)
-            : FVector(0, i * TileSize, 0));
-
-        AActor* NewWall = GetWorld()->SpawnActor<AActor>(WallPlacementClass, SegmentLocation, WallRotation);
-        if (NewWall)
-        {
-            NewWall->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
-        }
-    }
-
-    // Remove AI's wall resource
-    AQuoridorPawn* AIPawn = GetPawnForPlayer(CurrentPlayerTurn);
-    if (AIPawn)
-    {
-        AIPawn->RemoveWallOfLength(Length);
-    }
-
-    // Advance turn
-    CurrentPlayerTurn = (CurrentPlayerTurn == 1) ? 2 : 1;
-    SelectedPawn = GetPawnForPlayer(CurrentPlayerTurn);
+    // Advance turn (done once by ExecuteAction -> EndTurn)
+    // CurrentPlayerTurn = (CurrentPlayerTurn == 1) ? 2 : 1;
+    // SelectedPawn = GetPawnForPlayer(CurrentPlayerTurn);
 
     UE_LOG(LogTemp, Warning, TEXT("[ForcePlaceWallForAI] Wall placed (%d,%d) [%s] L=%d | Turn -> Player %d"),
         SlotX, SlotY, *UEnum::GetValueAsString(Orientation), Length, CurrentPlayerTurn);
@@ -327,7 +453,7 @@ void AAI_VS_AI::ExecuteAction(const FMinimaxAction& Act)
             if (Pawn && TargetTile)
             {
                 UE_LOG(LogTemp, Warning, TEXT("ExecuteAction: Player %d moving to tile (%d, %d)"), ActingPlayer, Act.MoveX, Act.MoveY);
-                if (PawnMoveSound)
+                if (PawnMoveSound && !bDeferPresentation)
                 {
                     UGameplayStatics::PlaySound2D(this, PawnMoveSound);
                 }
@@ -345,9 +471,8 @@ void AAI_VS_AI::ExecuteAction(const FMinimaxAction& Act)
     }
 
     // Advance turn to the other player
-    CurrentPlayerTurn = (ActingPlayer == 1) ? 2 : 1;
-    SelectedPawn = GetPawnForPlayer(CurrentPlayerTurn);
-    TurnCount++;
     bIsAITurnRunning = false;
+    EndTurn(ActingPlayer);
+    SelectedPawn = GetPawnForPlayer(CurrentPlayerTurn);
 }
 
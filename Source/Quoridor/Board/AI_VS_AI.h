@@ -3,9 +3,18 @@
 #include "CoreMinimal.h"
 #include "Quoridor/Board/QuoridorBoard.h"
 #include "MinimaxEngine.h"
+#include "MinimaxTimeManager.h"
 #include "Async/Async.h"
 #include "AI_VS_AI.generated.h"
 
+/** Satu ply yang sudah dicari dan diterapkan worker dalam segment fast-forward */
+struct FMinimaxChainedMove
+{
+	int32 Player = 0;
+	FMinimaxResult Result;
+	double ThinkSeconds = 0.0;
+};
+
 /**
  * A minimal AI subclass that captures board state, calls the pure-data
  * engine, then executes the returned action.
@@ -19,13 +28,18 @@ public:
 	AAI_VS_AI();
 	void BeginPlay();
 
-	virtual void Tick(float DeltaTime) override;
+	/** Starts the AI search if it is an AI player's turn; called from OnBoardReady / OnTurnChanged */
+	void TryStartAITurn();
+	UFUNCTION()
+	void HandleTurnChanged(int32 NewPlayerTurn, int32 NewTurnCount);
 	bool ForcePlaceWallForAI(int32 SlotX, int32 SlotY, int32 Length, bool bHorizontal);
 	void RunMinimax(int32 Player, int32 algo);
 	UPROPERTY()
 	bool bIsAITurnRunning = false;
-	float ElapsedTime;
-	bool bDelayPassed;
+	// True setelah OnBoardReady; menggantikan delay tetap 5 detik
+	bool bDelayPassed = false;
+	UFUNCTION()
+	void HandleBoardReady(AQuoridorBoard* Board);
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Settings")
 	int AI1Player;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Settings")
@@ -37,6 +51,25 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = "AI")
 	float GetTotalThinkingTimeForPlayer(int32 PlayerNum) const;
+
+	/** Time control per game dalam detik: base + increment per langkah. Base 0 = tanpa jam, search memakai Depth penuh */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Settings")
+	float TimeControlBaseSeconds = 0.f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Settings")
+	float TimeControlIncrementSeconds = 0.f;
+
+	UFUNCTION(BlueprintCallable, Category = "AI")
+	float GetRemainingClockForPlayer(int32 PlayerNum) const;
+	FMinimaxTimeManager TimeManager;
+
+	/**
+	 * Fast-forward untuk batch evaluasi: worker mencari dan menerapkan FastForwardSyncPlies ply berturut-turut
+	 * di FMinimaxState tanpa delay, lalu board terlihat disinkronkan sekali per segment (tanpa suara)
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Settings")
+	bool bFastForward = false;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Settings", meta = (ClampMin = "1", EditCondition = "bFastForward"))
+	int32 FastForwardSyncPlies = 8;
 	TArray<int32> InitialWallInventory;
 	UPROPERTY(BlueprintReadWrite)
 	FString AITypeName1 = "MinimaxParallel";
@@ -54,4 +87,7 @@ private:
 
 	// Execute the chosen action on the board
 	void ExecuteAction(const FMinimaxAction& Act);
+
+	void RunFastForwardSegment();
+	void ApplyFastForwardSegment(const TArray<FMinimaxChainedMove>& Moves, const FMinimaxTimeManager& ClockAfter);
 };
@@ -1,5 +1,7 @@
 ﻿#include "MinimaxBoardAI.h"
 #include "MinimaxEngine.h"
+#include "MinimaxSearchWorker.h"
+#include "MinimaxSearchProgress.h"
 #include "Quoridor/Board/QuoridorBoard.h"
 #include "Quoridor/Pawn/QuoridorPawn.h"
 #include "Kismet/GameplayStatics.h"
@@ -10,16 +12,19 @@
 
 AMinimaxBoardAI::AMinimaxBoardAI()
 {
-    // Enable ticking on this AI board if you plan to do per-frame logic
+    // AI turns are driven by OnTurnChanged / OnBoardReady; Tick only runs while a search publishes progress
     PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.bStartWithTickEnabled = false;
 }
 void AMinimaxBoardAI::BeginPlay()
 {
     Super::BeginPlay();
 
-    // Tick stays enabled, we use ElapsedTime to wait before acting
-    ElapsedTime = 0.0f;
-    bDelayPassed = false;
+    // AI logic waits for OnBoardReady instead of a fixed delay, then follows OnTurnChanged
+    bDelayPassed = IsBoardReady();
+    OnBoardReady.AddDynamic(this, &AMinimaxBoardAI::HandleBoardReady);
+    OnTurnChanged.AddDynamic(this, &AMinimaxBoardAI::HandleTurnChanged);
+    TimeManager.Reset(TimeControlBaseSeconds, TimeControlIncrementSeconds);
     
     if (bAI1IsPlayer1)
     {
@@ -35,23 +40,101 @@ void AMinimaxBoardAI::BeginPlay()
     }
 }
 
-void AMinimaxBoardAI::Tick(float DeltaTime)
+void AMinimaxBoardAI::Tick(float DeltaSeconds)
 {
-    Super::Tick(DeltaTime);
+    Super::Tick(DeltaSeconds);
 
-    GEngine->AddOnScreenDebugMessage(1, 0.0f, FColor::Cyan,
-        FString::Printf(TEXT("Turn: Player %d"), CurrentPlayerTurn));
+    if (!SearchProgress.IsValid() || bIsGameFinished)
+    {
+        ClearSearchProgress();
+        return;
+    }
 
-    // Wait a bit before AI logic kicks in
-    if (!bDelayPassed)
+    // Satu seqlock read per frame; search tidak pernah menunggu game thread
+    if (SearchProgress->GetSequence() == LastBroadcastSequence)
+        return;
+
+    FMinimaxSearchSnapshot Snapshot;
+    if (!SearchProgress->Read(Snapshot))
+        return;
+
+    LastBroadcastSequence = Snapshot.Sequence;
+    OnSearchProgress.Broadcast(SearchProgressPlayer, Snapshot.Depth, Snapshot.Score, Snapshot.NodesSearched,
+        static_cast<float>(Snapshot.GetNodesPerSecond()));
+}
+
+bool AMinimaxBoardAI::GetSearchProgress(FString& OutBestMove, int32& OutSearchDepth, int32& OutScore, int64& OutNodesSearched) const
+{
+    FMinimaxSearchSnapshot Snapshot;
+    if (!SearchProgress.IsValid() || !SearchProgress->Read(Snapshot))
+        return false;
+
+    const FMinimaxAction Best = Snapshot.GetBestAction();
+    OutBestMove = Best.bIsWall
+        ? FString::Printf(TEXT("Wall@(%d,%d) %s"), Best.SlotX, Best.SlotY, Best.bHorizontal ? TEXT("H") : TEXT("V"))
+        : FString::Printf(TEXT("Move(%d,%d)"), Best.MoveX, Best.MoveY);
+    OutSearchDepth = Snapshot.Depth;
+    OutScore = Snapshot.Score;
+    OutNodesSearched = Snapshot.NodesSearched;
+    return true;
+}
+
+bool AMinimaxBoardAI::StopSearchAndPlayBestMove()
+{
+    if (!bMinimaxInProgress || !SearchProgress.IsValid() || !SearchStopToken.IsValid() || bIsGameFinished)
+        return false;
+
+    FMinimaxSearchSnapshot Snapshot;
+    if (!SearchProgress->Read(Snapshot))
     {
-        ElapsedTime += DeltaTime;
-        if (ElapsedTime < 5.0f)
-            return;
+        UE_LOG(LogTemp, Warning, TEXT("StopSearchAndPlayBestMove: Belum ada move yang selesai dicari, search dilanjutkan"));
+        return false;
+    }
 
-        bDelayPassed = true;
-        UE_LOG(LogTemp, Warning, TEXT("AI logic delay passed, starting AI..."));
+    // Token di-cancel: hasil akhir search tidak pernah sampai ke FinishAITurn, jadi langkah ini dimainkan sekali
+    SearchStopToken->RequestStop();
+    UE_LOG(LogTemp, Warning, TEXT("StopSearchAndPlayBestMove: P%d berhenti di depth %d (selesai %d), %lld node"),
+        SearchProgressPlayer, Snapshot.Depth, Snapshot.CompletedDepth, Snapshot.NodesSearched);
+    FinishAITurn(SearchProgressPlayer, FMinimaxResult(Snapshot.GetBestAction(), Snapshot.Score));
+    return true;
+}
+
+void AMinimaxBoardAI::ClearSearchProgress()
+{
+    SearchProgress.Reset();
+    SearchStopToken.Reset();
+    LastBroadcastSequence = 0;
+    SetActorTickEnabled(false);
+}
+
+void AMinimaxBoardAI::HandleBoardReady(AQuoridorBoard* Board)
+{
+    bDelayPassed = true;
+    UE_LOG(LogTemp, Warning, TEXT("Board ready, starting AI..."));
+    if (CurrentPlayerTurn != AI1Player)
+    {
+        StartPondering();
     }
+    TryStartAITurn();
+}
+
+void AMinimaxBoardAI::HandleTurnChanged(int32 NewPlayerTurn, int32 NewTurnCount)
+{
+    // Giliran manusia: worker memakai waktu berpikir manusia untuk mencari balasan yang diprediksi
+    if (NewPlayerTurn != AI1Player)
+    {
+        StartPondering();
+    }
+
+    // Next tick: the async callback that ended the previous turn still clears bMinimaxInProgress after ExecuteAction
+    GetWorldTimerManager().SetTimerForNextTick(this, &AMinimaxBoardAI::TryStartAITurn);
+}
+
+void AMinimaxBoardAI::TryStartAITurn()
+{
+    // Wait for the board (tiles, connections, pawns) and stop once the game is over
+    if (!bDelayPassed || bIsGameFinished)
+        return;
     
     // if (bDelayPassed && CurrentPlayerTurn == AI1Player && !bIsAITurnRunning)
     // {
@@ -66,13 +149,16 @@ void AMinimaxBoardAI::Tick(float DeltaTime)
     //         UE_LOG(LogTemp, Warning, TEXT("AI pawn not ready yet"));
     //     }
     // }
-    if (bDelayPassed && CurrentPlayerTurn == AI1Player && !bIsAITurnRunning)
+    if (CurrentPlayerTurn == AI1Player && !bIsAITurnRunning)
     {
         AQuoridorPawn* P = GetPawnForPlayer(CurrentPlayerTurn);
         if (P && P->GetTile())
         {
             bIsAITurnRunning = true;
-            RunMinimax(AI1Player, 3);
+            if (!TryPlayPonderedMove())
+            {
+                RunMinimax(AI1Player, AIAlgorithmChoice);
+            }
         }
         else
         {
@@ -154,6 +240,13 @@ void AMinimaxBoardAI::RunMinimax(int32 Player, int32 algo)
         DelayHandle,
         [this, AIPlayer, Choice]()
         {
+            // Game bisa selesai selama delay; jangan mulai search yang hasilnya dibuang
+            if (bIsGameFinished)
+            {
+                bMinimaxInProgress = false;
+                return;
+            }
+
             if (AIPlayer == 1)
                 ThinkingStartTimeP1 = FPlatformTime::Seconds();
             else if (AIPlayer == 2)
@@ -162,64 +255,307 @@ void AMinimaxBoardAI::RunMinimax(int32 Player, int32 algo)
             FMinimaxState StateSnapshot = FMinimaxState::FromBoard(this);
             int32 defaultDepth = Depth;
 
-            // Run the actual minimax on a background thread
-            Async(EAsyncExecution::Thread, [this, StateSnapshot, defaultDepth, AIPlayer,Choice]()
+            // Run the actual minimax on the board's persistent search worker
+            FMinimaxSearchJob Job;
+            Job.Engine = GetSearchEngine(AIPlayer);
+            Job.GameId = GameId;
+            Job.TurnIndex = TurnCount;
+            Job.State = StateSnapshot;
+            Job.Depth = defaultDepth;
+            Job.PlayerTurn = AIPlayer;
+            Job.AlgorithmChoice = Choice;
+            Job.StopToken = MakeShared<FMinimaxStopToken>();
+            Job.Progress = MakeShared<FMinimaxSearchProgress>();
+
+            // Time control: Depth jadi batas atas iterative deepening, budget langkah ditegakkan lewat deadline
+            if (TimeManager.IsEnabled())
             {
-                FMinimaxResult Action = MinimaxEngine::RunSelectedAlgorithm(StateSnapshot,defaultDepth,AIPlayer,Choice);
+                const double Budget = TimeManager.AllocateMoveBudget(AIPlayer, StateSnapshot);
+                Job.bIterativeDeepening = true;
+                Job.StopToken->SetDeadline(FPlatformTime::Seconds() + Budget);
+                UE_LOG(LogTemp, Log, TEXT("[TimeControl] P%d budget %.3f s | clock %.3f s"),
+                    AIPlayer, Budget, TimeManager.GetRemainingSeconds(AIPlayer));
+            }
 
-                // Once SolveParallel finishes, come back to GameThread to execute the move
-                AsyncTask(ENamedThreads::GameThread, [this, Action, AIPlayer]()
-                {
-                    double EndTime = FPlatformTime::Seconds();
-                    double Elapsed = 0.0;
-
-                    if (AIPlayer == 1)
-                    {
-                        Elapsed = EndTime - ThinkingStartTimeP1;
-                        TotalThinkingTimeP1 += Elapsed;
-                        UE_LOG(LogTemp, Warning, TEXT("[AI P1] Thinking Time: %.4f s | Total: %.4f s"), Elapsed, TotalThinkingTimeP1);
-                    }
-                    else if (AIPlayer == 2)
-                    {
-                        
-                        Elapsed = EndTime - ThinkingStartTimeP2;
-                        TotalThinkingTimeP2 += Elapsed;
-                        UE_LOG(LogTemp, Warning, TEXT("[AI P2] Thinking Time: %.4f s | Total: %.4f s"), Elapsed, TotalThinkingTimeP2);
-                    }
-                    const FMinimaxAction& BestAct = Action.BestAction;
-                    ExecuteAction(BestAct);
-
-                    // Swap turn after action is done
-                    // CurrentPlayerTurn = (AIPlayer == 1) ? 2 : 1;
-                    // SelectedPawn = GetPawnForPlayer(CurrentPlayerTurn);
-                    bMinimaxInProgress = false;
-
-                    // 4) Log detail aksi dan skor:
-                    if (BestAct.bIsWall)
-                    {
-                        UE_LOG(LogTemp, Warning,
-                            TEXT("=> Engine chose: Wall @(%d,%d) %s (score=%d)"),
-                            BestAct.SlotX,
-                            BestAct.SlotY,
-                            BestAct.bHorizontal ? TEXT("H") : TEXT("V"),
-                            Action.BestValue);
-                    }
-                    else
-                    {
-                        UE_LOG(LogTemp, Warning,
-                            TEXT("=> Engine chose: Move to (%d,%d) (score=%d)"),
-                            BestAct.MoveX,
-                            BestAct.MoveY,
-                            Action.BestValue);
-                    }
-                });
-            });
+            // Once the worker finishes, come back to GameThread to execute the move
+            TWeakObjectPtr<AMinimaxBoardAI> WeakThis(this);
+            Job.OnCompleteGameThread = [this, WeakThis, AIPlayer, Token = Job.StopToken](const FMinimaxResult& Action)
+            {
+                // Cancelled setelah hasil dikirim: StopSearchAndPlayBestMove sudah memainkan langkahnya
+                if (!WeakThis.IsValid() || Token->IsCancelled())
+                    return;
+
+                FinishAITurn(AIPlayer, Action);
+            };
+
+            // Move terbaik sejauh ini di-poll dari Tick (live analysis / early stop)
+            SearchProgress = Job.Progress;
+            SearchProgressPlayer = AIPlayer;
+            LastBroadcastSequence = 0;
+            SearchStopToken = GetSearchWorker().Enqueue(MoveTemp(Job));
+            SetActorTickEnabled(true);
         },
         2.0f,    // Delay in seconds
         false    // Do not loop
     );
 }
 
+void AMinimaxBoardAI::FinishAITurn(int32 AIPlayer, const FMinimaxResult& Action)
+{
+    double EndTime = FPlatformTime::Seconds();
+    double Elapsed = 0.0;
+
+    if (AIPlayer == 1)
+    {
+        Elapsed = EndTime - ThinkingStartTimeP1;
+        TotalThinkingTimeP1 += Elapsed;
+        UE_LOG(LogTemp, Warning, TEXT("[AI P1] Thinking Time: %.4f s | Total: %.4f s"), Elapsed, TotalThinkingTimeP1);
+    }
+    else if (AIPlayer == 2)
+    {
+        
+        Elapsed = EndTime - ThinkingStartTimeP2;
+        TotalThinkingTimeP2 += Elapsed;
+        UE_LOG(LogTemp, Warning, TEXT("[AI P2] Thinking Time: %.4f s | Total: %.4f s"), Elapsed, TotalThinkingTimeP2);
+    }
+    TimeManager.FinishMove(AIPlayer, Elapsed, Action.BestValue);
+    ClearSearchProgress();
+    const FMinimaxAction& BestAct = Action.BestAction;
+    ExecuteAction(BestAct);
+
+    // Swap turn after action is done
+    // CurrentPlayerTurn = (AIPlayer == 1) ? 2 : 1;
+    // SelectedPawn = GetPawnForPlayer(CurrentPlayerTurn);
+    bMinimaxInProgress = false;
+
+    // 4) Log detail aksi dan skor:
+    if (BestAct.bIsWall)
+    {
+        UE_LOG(LogTemp, Warning,
+            TEXT("=> Engine chose: Wall @(%d,%d) %s (score=%d)"),
+            BestAct.SlotX,
+            BestAct.SlotY,
+            BestAct.bHorizontal ? TEXT("H") : TEXT("V"),
+            Action.BestValue);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning,
+            TEXT("=> Engine chose: Move to (%d,%d) (score=%d)"),
+            BestAct.MoveX,
+            BestAct.MoveY,
+            Action.BestValue);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Pondering: prediksi langkah manusia, lalu cari balasan AI untuk setiap
+// prediksi di worker selagi manusia berpikir
+//-----------------------------------------------------------------------------
+void AMinimaxBoardAI::StartPondering()
+{
+    StopPondering();
+
+    if (!bEnablePondering || !bDelayPassed || bIsGameFinished)
+        return;
+
+    const FMinimaxState Root = FMinimaxState::FromBoard(this);
+    const int32 HumanPlayer = 3 - AI1Player;
+    const uint32 Generation = PonderGeneration;
+
+    // Prediksi langkah manusia dengan search satu ply lebih dangkal dari perspektif manusia
+    FMinimaxSearchJob Job;
+    Job.Engine = GetSearchEngine(HumanPlayer);
+    Job.GameId = GameId;
+    Job.TurnIndex = TurnCount;
+    Job.State = Root;
+    Job.Depth = FMath::Max(1, Depth - 1);
+    Job.PlayerTurn = HumanPlayer;
+    Job.AlgorithmChoice = AIAlgorithmChoice;
+
+    TWeakObjectPtr<AMinimaxBoardAI> WeakThis(this);
+    Job.OnCompleteGameThread = [this, WeakThis, Generation, Root](const FMinimaxResult& Prediction)
+    {
+        if (!WeakThis.IsValid())
+            return;
+
+        HandlePonderPrediction(Generation, Root, Prediction);
+    };
+    PonderPredictionToken = GetSearchWorker().Enqueue(MoveTemp(Job));
+}
+
+void AMinimaxBoardAI::StopPondering()
+{
+    ++PonderGeneration;
+    PonderHitIndex = INDEX_NONE;
+
+    if (PonderPredictionToken.IsValid())
+    {
+        PonderPredictionToken->RequestStop();
+        PonderPredictionToken.Reset();
+    }
+
+    for (const FMinimaxPonderEntry& Entry : PonderEntries)
+    {
+        if (Entry.StopToken.IsValid())
+        {
+            Entry.StopToken->RequestStop();
+        }
+    }
+    PonderEntries.Reset();
+}
+
+void AMinimaxBoardAI::HandlePonderPrediction(uint32 Generation, const FMinimaxState& Root, const FMinimaxResult& Prediction)
+{
+    if (Generation != PonderGeneration || bIsGameFinished)
+        return;
+
+    PonderPredictionToken.Reset();
+
+    const int32 HumanPlayer = 3 - AI1Player;
+    const TArray<FIntPoint> HumanMoves = MinimaxEngine::GetPawnMoves(Root, HumanPlayer);
+
+    // 1) Langkah terbaik manusia menurut engine
+    const FMinimaxAction& Predicted = Prediction.BestAction;
+    const bool bPredictedValid = Predicted.bIsWall
+        ? (Predicted.WallLength > 0 && Root.WallsRemaining[HumanPlayer - 1] > 0)
+        : HumanMoves.Contains(FIntPoint(Predicted.MoveX, Predicted.MoveY));
+    if (bPredictedValid)
+    {
+        EnqueuePonderSearch(Generation, Root, Predicted);
+    }
+
+    // 2) Manusia sering sekadar maju di shortest path-nya; cari juga balasan untuk langkah itu
+    const TArray<FIntPoint> HumanPath = MinimaxEngine::ComputePathToGoal(Root, HumanPlayer);
+    if (HumanPath.Num() > 1 && HumanMoves.Contains(HumanPath[1]))
+    {
+        const bool bSameAsPredicted = bPredictedValid && !Predicted.bIsWall &&
+            Predicted.MoveX == HumanPath[1].X && Predicted.MoveY == HumanPath[1].Y;
+        if (!bSameAsPredicted)
+        {
+            EnqueuePonderSearch(Generation, Root, FMinimaxAction(HumanPath[1].X, HumanPath[1].Y));
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("[Ponder] %d predicted reply position(s) queued"), PonderEntries.Num());
+}
+
+void AMinimaxBoardAI::EnqueuePonderSearch(uint32 Generation, const FMinimaxState& Root, const FMinimaxAction& HumanAction)
+{
+    const int32 HumanPlayer = 3 - AI1Player;
+
+    FMinimaxPonderEntry& Entry = PonderEntries.AddDefaulted_GetRef();
+    Entry.PredictedHumanAction = HumanAction;
+    Entry.PredictedState = Root;
+    if (HumanAction.bIsWall)
+    {
+        FWallData W{ HumanAction.SlotX, HumanAction.SlotY, HumanAction.WallLength, HumanAction.bHorizontal };
+        MinimaxEngine::ApplyWall(Entry.PredictedState, HumanPlayer, W);
+    }
+    else
+    {
+        MinimaxEngine::ApplyPawnMove(Entry.PredictedState, HumanPlayer, HumanAction.MoveX, HumanAction.MoveY);
+    }
+
+    FMinimaxSearchJob Job;
+    Job.Engine = GetSearchEngine(AI1Player);
+    Job.GameId = GameId;
+    Job.TurnIndex = TurnCount + 1; // giliran AI setelah langkah manusia yang diprediksi
+    Job.State = Entry.PredictedState;
+    Job.Depth = Depth;
+    Job.PlayerTurn = AI1Player;
+    Job.AlgorithmChoice = AIAlgorithmChoice;
+
+    const int32 Index = PonderEntries.Num() - 1;
+    TWeakObjectPtr<AMinimaxBoardAI> WeakThis(this);
+    Job.OnCompleteGameThread = [this, WeakThis, Generation, Index](const FMinimaxResult& Result)
+    {
+        if (!WeakThis.IsValid() || Generation != PonderGeneration || !PonderEntries.IsValidIndex(Index))
+            return;
+
+        PonderEntries[Index].Result = Result;
+        PonderEntries[Index].bDone = true;
+
+        // Giliran AI sudah mulai dan menunggu entry ini
+        if (PonderHitIndex == Index)
+        {
+            StopPondering();
+            FinishAITurn(AI1Player, Result);
+        }
+    };
+    Entry.StopToken = GetSearchWorker().Enqueue(MoveTemp(Job));
+}
+
+bool AMinimaxBoardAI::TryPlayPonderedMove()
+{
+    if (!bEnablePondering || PonderEntries.Num() == 0)
+    {
+        StopPondering();
+        return false;
+    }
+
+    const FMinimaxState Actual = FMinimaxState::FromBoard(this);
+    const int32 Hit = PonderEntries.IndexOfByPredicate([&Actual](const FMinimaxPonderEntry& Entry)
+    {
+        return Entry.PredictedState.HasSamePosition(Actual);
+    });
+
+    if (Hit == INDEX_NONE)
+    {
+        ++PonderMisses;
+        UE_LOG(LogTemp, Log, TEXT("[Ponder] Miss (hits=%d misses=%d), searching from scratch"), PonderHits, PonderMisses);
+        StopPondering();
+        return false;
+    }
+
+    ++PonderHits;
+
+    // Time control: search ponder di-enqueue tanpa deadline (budget belum diketahui), jadi menunggunya
+    // bisa menghabiskan clock. Batalkan dan cari ulang lewat RunMinimax dengan budget langkah ini;
+    // TT engine AI sudah terisi search ponder di root yang sama, jadi iterasi awalnya murah.
+    if (!PonderEntries[Hit].bDone && TimeManager.IsEnabled())
+    {
+        UE_LOG(LogTemp, Log, TEXT("[Ponder] Hit (hits=%d misses=%d), search not finished, re-searching with the move budget"),
+            PonderHits, PonderMisses);
+        StopPondering();
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("[Ponder] Hit (hits=%d misses=%d)%s"), PonderHits, PonderMisses,
+        PonderEntries[Hit].bDone ? TEXT(", playing instantly") : TEXT(", waiting for the running search"));
+
+    // Prediksi lain tidak berguna lagi; worker bisa langsung lanjut ke entry yang cocok
+    for (int32 i = 0; i < PonderEntries.Num(); ++i)
+    {
+        if (i != Hit && PonderEntries[i].StopToken.IsValid())
+        {
+            PonderEntries[i].StopToken->RequestStop();
+        }
+    }
+
+    bMinimaxInProgress = true;
+    if (AI1Player == 1)
+        ThinkingStartTimeP1 = FPlatformTime::Seconds();
+    else
+        ThinkingStartTimeP2 = FPlatformTime::Seconds();
+
+    if (PonderEntries[Hit].bDone)
+    {
+        const FMinimaxResult Result = PonderEntries[Hit].Result;
+        StopPondering();
+        FinishAITurn(AI1Player, Result);
+        return true;
+    }
+
+    PonderHitIndex = Hit;
+    return true;
+}
+
+float AMinimaxBoardAI::GetRemainingClockForPlayer(int32 PlayerNum) const
+{
+    return static_cast<float>(TimeManager.GetRemainingSeconds(PlayerNum));
+}
+
 float AMinimaxBoardAI::GetTotalThinkingTimeForPlayer(int32 PlayerNum) const
 {
     if (PlayerNum == 1)
@@ -233,9 +569,8 @@ float AMinimaxBoardAI::GetTotalThinkingTimeForPlayer(int32 PlayerNum) const
 bool AMinimaxBoardAI::ForcePlaceWallForAI(int32 SlotX, int32 SlotY, int32 Length, bool bHorizontal)
 {
     EWallOrientation Orientation = bHorizontal ? EWallOrientation::Horizontal : EWallOrientation::Vertical;
-    AWallSlot* StartSlot = FindWallSlotAt(SlotX, SlotY, Orientation);
     
-    if (!StartSlot || Length <= 0)
+    if (!IsWallSlotInBounds(SlotX, SlotY, Orientation) || Length <= 0)
     {
         UE_LOG(LogTemp, Error, TEXT("[ForcePlaceWallForAI] Invalid StartSlot or Length=0"));
         return false;
@@ -244,62 +579,22 @@ bool AMinimaxBoardAI::ForcePlaceWallForAI(int32 SlotX, int32 SlotY, int32 Length
     PendingWallLength = Length;
     PendingWallOrientation = Orientation;
 
-    // Gather affected slots
-    TArray<AWallSlot*> AffectedSlots;
-    AffectedSlots.Add(StartSlot);
-
+    // Validate every segment against the grid
     for (int i = 1; i < Length; ++i)
     {
         int32 NextX = SlotX + (bHorizontal ? i : 0);
         int32 NextY = SlotY + (bHorizontal ? 0 : i);
-        AWallSlot* NextSlot = FindWallSlotAt(NextX, NextY, Orientation);
 
-        if (!NextSlot)
+        if (!IsWallSlotInBounds(NextX, NextY, Orientation))
         {
             UE_LOG(LogTemp, Error, TEXT("[ForcePlaceWallForAI] Slot (%d,%d) [%s] not found"),
                 NextX, NextY, *UEnum::GetValueAsString(Orientation));
             return false;
         }
-
-        AffectedSlots.Add(NextSlot);
-    }
-
-    // Mark slots as occupied
-    for (AWallSlot* Slot : AffectedSlots)
-    {
-        Slot->SetOccupied(true);
-        UE_LOG(LogTemp, Warning, TEXT("Wall segment marked occupied at (%d,%d) [%s]"),
-            Slot->GridX, Slot->GridY, *UEnum::GetValueAsString(Orientation));
-    }
-    
-    if (WallClickSound)
-    {
-        UGameplayStatics::PlaySound2D(this, WallClickSound);
-    }
-
-    // Spawn visual wall mesh segments
-    FVector BaseLocation = StartSlot->GetActorLocation();
-    FRotator WallRotation = bHorizontal ? FRotator::ZeroRotator : FRotator(0, 90, 0);
-
-    for (int i = 0; i < Length; ++i)
-    {
-        FVector SegmentLocation = BaseLocation + (bHorizontal
-            ? FVector(i * TileSize, 0, 0)
-            : FVector(0, i * TileSize, 0));
-
-        AActor* NewWall = GetWorld()->SpawnActor<AActor>(WallPlacementClass, SegmentLocation, WallRotation);
-        if (NewWall)
-        {
-            NewWall->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
-        }
     }
 
-    // Remove AI's wall resource
-    AQuoridorPawn* AIPawn = GetPawnForPlayer(CurrentPlayerTurn);
-    if (AIPawn)
-    {
-        AIPawn->RemoveWallOfLength(Length);
-    }
+    // Board model, legacy slots, visual segments and the AI's wall resource
+    CommitWallPlacement(SlotX, SlotY, Orientation, Length, CurrentPlayerTurn);
 
     // Advance turn
     // CurrentPlayerTurn = (CurrentPlayerTurn == 1) ? 2 : 1;
@@ -369,10 +664,8 @@ void AMinimaxBoardAI::ExecuteAction(const FMinimaxAction& Act)
     }
 
     // Advance turn to the other player
-    CurrentPlayerTurn = (ActingPlayer == 1) ? 2 : 1;
-    SelectedPawn = GetPawnForPlayer(CurrentPlayerTurn);
-    SelectedPawn = nullptr;
-    TurnCount++;
     bIsAITurnRunning = false;
+    SelectedPawn = nullptr;
+    EndTurn(ActingPlayer);
 }
 
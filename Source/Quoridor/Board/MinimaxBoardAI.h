@@ -3,9 +3,24 @@
 #include "CoreMinimal.h"
 #include "Quoridor/Board/QuoridorBoard.h"
 #include "MinimaxEngine.h"
+#include "MinimaxTimeManager.h"
 #include "Async/Async.h"
 #include "MinimaxBoardAI.generated.h"
 
+class FMinimaxSearchProgress;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FiveParams(FOnMinimaxSearchProgress, int32, Player, int32, SearchDepth, int32, Score, int64, NodesSearched, float, NodesPerSecond);
+
+/** Satu langkah manusia yang diprediksi beserta balasan AI yang sedang / sudah dicari worker */
+struct FMinimaxPonderEntry
+{
+	FMinimaxState PredictedState;
+	FMinimaxAction PredictedHumanAction;
+	TSharedPtr<FMinimaxStopToken> StopToken;
+	FMinimaxResult Result;
+	bool bDone = false;
+};
+
 /**
  * A minimal AI subclass that captures board state, calls the pure-data
  * engine, then executes the returned action.
@@ -18,8 +33,12 @@ class QUORIDOR_API AMinimaxBoardAI : public AQuoridorBoard
 public:
 	AMinimaxBoardAI();
 	void BeginPlay();
+	virtual void Tick(float DeltaSeconds) override;
 
-	virtual void Tick(float DeltaTime) override;
+	/** Starts the AI search if it is an AI player's turn; called from OnBoardReady / OnTurnChanged */
+	void TryStartAITurn();
+	UFUNCTION()
+	void HandleTurnChanged(int32 NewPlayerTurn, int32 NewTurnCount);
 	void RunMinimaxForParallelAlphaBeta(int32 Player);
 	bool ForcePlaceWallForAI(int32 SlotX, int32 SlotY, int32 Length, bool bHorizontal);
 
@@ -27,12 +46,22 @@ public:
 	void RunMinimaxForAlphaBeta(int32 Player);
 	UPROPERTY()
 	bool bIsAITurnRunning = false;
-	float ElapsedTime;
-	bool bDelayPassed;
+	// True setelah OnBoardReady; menggantikan delay tetap 5 detik
+	bool bDelayPassed = false;
+	UFUNCTION()
+	void HandleBoardReady(AQuoridorBoard* Board);
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Settings")
 	int AI1Player;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Settings")
 	int AI2Player;
+
+	/** Algoritma RunSelectedAlgorithm untuk AI (dan pondering-nya) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Settings")
+	int32 AIAlgorithmChoice = 3;
+
+	/** Selama giliran manusia, cari balasan AI untuk langkah manusia yang diprediksi */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Settings")
+	bool bEnablePondering = true;
 	
 	
 	bool bMinimaxInProgress = false;
@@ -42,6 +71,28 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = "AI")
 	float GetTotalThinkingTimeForPlayer(int32 PlayerNum) const;
+
+	/** Time control per game dalam detik: base + increment per langkah. Base 0 = tanpa jam, search memakai Depth penuh */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Settings")
+	float TimeControlBaseSeconds = 0.f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Settings")
+	float TimeControlIncrementSeconds = 0.f;
+
+	UFUNCTION(BlueprintCallable, Category = "AI")
+	float GetRemainingClockForPlayer(int32 PlayerNum) const;
+
+	/** Live analysis: di-broadcast dari Tick setiap kali search AI mempublikasikan progress baru */
+	UPROPERTY(BlueprintAssignable, Category = "AI")
+	FOnMinimaxSearchProgress OnSearchProgress;
+
+	/** Progress terakhir search AI yang sedang berjalan; false jika belum ada move yang selesai dicari */
+	UFUNCTION(BlueprintCallable, Category = "AI")
+	bool GetSearchProgress(FString& OutBestMove, int32& OutSearchDepth, int32& OutScore, int64& OutNodesSearched) const;
+
+	/** Hentikan search AI sekarang dan mainkan move terbaik yang sudah dipublikasikan; false jika belum ada */
+	UFUNCTION(BlueprintCallable, Category = "AI")
+	bool StopSearchAndPlayBestMove();
+	FMinimaxTimeManager TimeManager;
 	TArray<int32> InitialWallInventory;
 	UPROPERTY(BlueprintReadWrite)
 	FString AITypeName1 = "MinimaxParallel";
@@ -59,4 +110,36 @@ private:
 
 	// Execute the chosen action on the board
 	void ExecuteAction(const FMinimaxAction& Act);
+
+	/** Catat thinking time, jalankan aksi, lalu log pilihan engine */
+	void FinishAITurn(int32 AIPlayer, const FMinimaxResult& Action);
+
+	// --- Pondering ---
+	void StartPondering();
+	void StopPondering();
+	void HandlePonderPrediction(uint32 Generation, const FMinimaxState& Root, const FMinimaxResult& Prediction);
+	void EnqueuePonderSearch(uint32 Generation, const FMinimaxState& Root, const FMinimaxAction& HumanAction);
+
+	/** Dipanggil di awal giliran AI: true jika langkah manusia cocok dengan prediksi dan hasil ponder dipakai */
+	bool TryPlayPonderedMove();
+
+	TArray<FMinimaxPonderEntry> PonderEntries;
+	TSharedPtr<FMinimaxStopToken> PonderPredictionToken;
+
+	// Naik setiap ponder dimulai / dihentikan; callback dari generasi lama diabaikan
+	uint32 PonderGeneration = 0;
+
+	// Entry yang cocok tapi belum selesai dicari (hanya tanpa time control); hasilnya langsung dimainkan saat tiba
+	int32 PonderHitIndex = INDEX_NONE;
+
+	int32 PonderHits = 0;
+	int32 PonderMisses = 0;
+
+	// --- Search progress (giliran AI yang sedang dicari) ---
+	void ClearSearchProgress();
+
+	TSharedPtr<FMinimaxSearchProgress> SearchProgress;
+	TSharedPtr<FMinimaxStopToken> SearchStopToken;
+	int32 SearchProgressPlayer = 0;
+	uint32 LastBroadcastSequence = 0;
 };
@@ -10,109 +10,326 @@
 #include "Async/ParallelFor.h"
 #include "Quoridor/Pawn/QuoridorPawn.h"
 #include "Math/UnrealMathUtility.h"
-TArray<FIntPoint> MinimaxEngine::RecentMoves;
 
+MinimaxEngine::MinimaxEngine(int32 TranspositionTableSizeMB)
+    : TranspositionTable(TranspositionTableSizeMB)
+{
+    ClearSearchCaches();
+}
+
+bool MinimaxEngine::LoadLearnedEvaluator(const FString& Path)
+{
+    TSharedPtr<FMinimaxNNUE> Network = MakeShared<FMinimaxNNUE>();
+    if (!Network->LoadFromFile(Path))
+    {
+        return false;
+    }
+    LearnedEvaluator = Network;
+    return true;
+}
+
+FMinimaxSearchStats MinimaxEngine::GetStats() const
+{
+    FMinimaxSearchStats Stats;
+    Stats.NodesSearched = NodesSearched.Load(EMemoryOrder::Relaxed);
+    Stats.TTProbes = TTProbes.Load(EMemoryOrder::Relaxed);
+    Stats.TTHits = TTHits.Load(EMemoryOrder::Relaxed);
+    Stats.TTCutoffs = TTCutoffs.Load(EMemoryOrder::Relaxed);
+    return Stats;
+}
+
+void MinimaxEngine::ResetStats()
+{
+    NodesSearched = 0;
+    TTProbes = 0;
+    TTHits = 0;
+    TTCutoffs = 0;
+}
+
+void MinimaxEngine::ClearSearchCaches()
+{
+    TranspositionTable.Clear();
+    for (int32 idx = 0; idx < 2; ++idx)
+    {
+        for (int32 i = 0; i < HistorySize; ++i)
+            History[idx][i].Store(0, EMemoryOrder::Relaxed);
+    }
+    LastRootKey = 0;
+    CurrentTurnIndex = INDEX_NONE;
+    PreviousPV.Reset();
+}
+
+void MinimaxEngine::BeginGame(uint64 GameId)
+{
+    if (GameId == 0 || GameId == CurrentGameId)
+        return;
+
+    // Isi cache game lain tidak relevan (inventory wall dan posisi awal bisa berbeda)
+    if (CurrentGameId != 0)
+        ClearSearchCaches();
+    CurrentGameId = GameId;
+}
+
+void MinimaxEngine::BeginTurn(int32 TurnIndex)
+{
+    if (TurnIndex == CurrentTurnIndex)
+        return;
+
+    if (bKeepCachesAcrossTurns)
+        AgeHistory();
+    else
+        ClearSearchCaches();
+    CurrentTurnIndex = TurnIndex;
+}
+
+void MinimaxEngine::SetProgressMailbox(FMinimaxSearchProgress* InProgress)
+{
+    ProgressMailbox = InProgress;
+    ProgressNodeBase = NodesSearched.Load();
+}
+
+void MinimaxEngine::ReportRootMove(const FMinimaxAction& Act, int32 Value, const FMinimaxStopToken* Stop)
+{
+    // Nilai child dari search yang di-stop tidak bermakna
+    if (ProgressMailbox && !IsSearchStopped(Stop))
+        ProgressMailbox->OfferRootMove(Act, Value, CurrentRootDepth, NodesSearched.Load() - ProgressNodeBase);
+}
+
+FMinimaxResult MinimaxEngine::FinishRootSearch(const FMinimaxState& Root, int32 PlayerTurn, const FMinimaxResult& Result, const FMinimaxStopToken* Stop)
+{
+    if (IsSearchStopped(Stop))
+        return Result;
+
+    RememberPrincipalVariation(Root, PlayerTurn, Result.BestAction);
+    if (ProgressMailbox)
+        ProgressMailbox->CompleteDepth(Result.BestAction, Result.BestValue, CurrentRootDepth, NodesSearched.Load() - ProgressNodeBase);
+    return Result;
+}
+
+void MinimaxEngine::ParallelForCapped(int32 Num, TFunctionRef<void(int32)> Body) const
+{
+    const int32 Cap = MaxSearchThreads;
+    if (Cap <= 0)
+    {
+        ParallelFor(Num, Body);
+        return;
+    }
+
+    if (Cap == 1 || Num <= 1)
+    {
+        for (int32 i = 0; i < Num; ++i)
+            Body(i);
+        return;
+    }
+
+    const int32 Lanes = FMath::Min(Cap, Num);
+    ParallelFor(Lanes, [&](int32 Lane)
+    {
+        for (int32 i = Lane; i < Num; i += Lanes)
+            Body(i);
+    });
+}
 
 //-----------------------------------------------------------------------------
-// FMinimaxState::FromBoard (bener)
+// Transposition table & move ordering
 //-----------------------------------------------------------------------------
-FMinimaxState FMinimaxState::FromBoard(AQuoridorBoard* Board)
+int32 MinimaxEngine::HistoryIndex(const FMinimaxAction& Act)
 {
-    FMinimaxState S;
+    if (!Act.bIsWall)
+        return FMath::Clamp(Act.MoveY * 9 + Act.MoveX, 0, 80);
 
-    // 1) Zero‐out all blocked‐edge arrays
-    for (int y = 0; y < 8; ++y)
-        for (int x = 0; x < 9; ++x)
-            S.HorizontalBlocked[y][x] = false;
+    const int32 Plane = (FMath::Clamp(Act.WallLength, 1, 3) - 1) * 2 + (Act.bHorizontal ? 1 : 0);
+    return 81 + Plane * 81 + FMath::Clamp(Act.SlotY * 9 + Act.SlotX, 0, 80);
+}
 
-    for (int y = 0; y < 9; ++y)
-        for (int x = 0; x < 8; ++x)
-            S.VerticalBlocked[y][x] = false;
+bool MinimaxEngine::ProbeTranspositionTable(uint64 Key, int32 Depth, int32 alpha, int32 beta, FMinimaxResult& OutResult, uint16& OutPackedAction)
+{
+    ++TTProbes;
+
+    FMinimaxTTEntry Entry;
+    if (!TranspositionTable.Probe(Key, Entry))
+        return false;
+
+    // Entry giliran lalu (generasi lain) dan hint PV hanya memberi move: nilainya dihitung dengan IdealPath root lama
+    OutPackedAction = Entry.PackedAction;
+    if (Entry.Generation != TranspositionTable.GetGeneration() || Entry.Bound == EMinimaxBound::None)
+        return false;
+
+    ++TTHits;
+    if (Entry.Depth < Depth)
+        return false;
+
+    const bool bCutoff =
+        Entry.Bound == EMinimaxBound::Exact ||
+        (Entry.Bound == EMinimaxBound::Lower && Entry.Value >= beta) ||
+        (Entry.Bound == EMinimaxBound::Upper && Entry.Value <= alpha);
+    if (!bCutoff)
+        return false;
+
+    ++TTCutoffs;
+    OutResult = FMinimaxResult(FMinimaxTranspositionTable::DecodeAction(Entry.PackedAction), Entry.Value);
+    return true;
+}
+
+void MinimaxEngine::StoreTranspositionTable(uint64 Key, int32 Depth, int32 AlphaOrig, int32 BetaOrig, const FMinimaxResult& Result, const FMinimaxStopToken* Stop)
+{
+    // Hasil search yang dihentikan, atau node tanpa satu pun candidate legal, tidak bermakna
+    if (IsSearchStopped(Stop) || Result.BestValue == INT_MIN || Result.BestValue == INT_MAX)
+        return;
+
+    EMinimaxBound Bound = EMinimaxBound::Exact;
+    if (Result.BestValue <= AlphaOrig)
+        Bound = EMinimaxBound::Upper;
+    else if (Result.BestValue >= BetaOrig)
+        Bound = EMinimaxBound::Lower;
 
-    // 2) Copy pawn positions + wall counts
-    for (int player = 1; player <= 2; ++player)
+    TranspositionTable.Store(Key, Result.BestValue, Depth, Bound, FMinimaxTranspositionTable::EncodeAction(Result.BestAction));
+}
+
+void MinimaxEngine::OrderCandidates(TArray<FMinimaxAction>& Candidates, int32 PlayerNum, uint16 TTPackedAction) const
+{
+    const int32 idx = PlayerNum - 1;
+
+    TArray<TPair<int32, FMinimaxAction>> Scored;
+    Scored.Reserve(Candidates.Num());
+    bool bAnyScore = false;
+    for (const FMinimaxAction& Act : Candidates)
     {
-        AQuoridorPawn* P = Board->GetPawnForPlayer(player);
-        int idx = player - 1;
+        const int32 Score = (TTPackedAction != 0 && FMinimaxTranspositionTable::EncodeAction(Act) == TTPackedAction)
+            ? INT_MAX
+            : History[idx][HistoryIndex(Act)].Load(EMemoryOrder::Relaxed);
+        bAnyScore |= (Score != 0);
+        Scored.Emplace(Score, Act);
+    }
 
-        if (P && P->GetTile())
-        {
-            S.PawnX[idx] = P->GetTile()->GridX;
-            S.PawnY[idx] = P->GetTile()->GridY;
-        }
-        else
+    if (!bAnyScore)
+        return;
+
+    Scored.StableSort([](const TPair<int32, FMinimaxAction>& A, const TPair<int32, FMinimaxAction>& B)
+    {
+        return A.Key > B.Key;
+    });
+    for (int32 i = 0; i < Scored.Num(); ++i)
+        Candidates[i] = Scored[i].Value;
+}
+
+void MinimaxEngine::RecordCutoff(int32 PlayerNum, const FMinimaxAction& Act, int32 Depth, const FMinimaxStopToken* Stop)
+{
+    // Child yang dihentikan mengembalikan FMinimaxResult() (nilai 0), jadi "cutoff"-nya palsu
+    if (IsSearchStopped(Stop))
+        return;
+
+    TAtomic<int32>& Entry = History[PlayerNum - 1][HistoryIndex(Act)];
+
+    // Bonus depth^2; dibagi dua saat hampir overflow supaya urutan relatif tetap
+    const int32 Bonus = Depth * Depth;
+    if (Entry.Load(EMemoryOrder::Relaxed) > (1 << 28))
+        Entry.Store(Entry.Load(EMemoryOrder::Relaxed) / 2, EMemoryOrder::Relaxed);
+    Entry.AddExchange(Bonus);
+}
+
+void MinimaxEngine::AgeHistory()
+{
+    // Dibagi 16, bukan 2: skor giliran lalu berasal dari iterasi dalam (bonus depth^2) dan kalau hanya dibagi dua
+    // masih mengalahkan cutoff iterasi dangkal giliran ini; sisanya tetap jadi tie-break ordering
+    for (int32 idx = 0; idx < 2; ++idx)
+    {
+        for (int32 i = 0; i < HistorySize; ++i)
+            History[idx][i].Store(History[idx][i].Load(EMemoryOrder::Relaxed) / 16, EMemoryOrder::Relaxed);
+    }
+}
+
+void MinimaxEngine::RememberPrincipalVariation(const FMinimaxState& Root, int32 PlayerTurn, const FMinimaxAction& RootAction)
+{
+    PreviousPV.Reset();
+
+    FMinimaxState S = Root;
+    int32 Mover = PlayerTurn;
+    FMinimaxAction Act = RootAction;
+    for (int32 Ply = 0; Ply < CurrentRootDepth; ++Ply)
+    {
+        const uint64 Key = FMinimaxTranspositionTable::HashState(S, Mover, PlayerTurn);
+        if (Ply > 0)
         {
-            S.PawnX[idx] = -1;
-            S.PawnY[idx] = -1;
-            UE_LOG(LogTemp, Error, TEXT("FromBoard: Player %d pawn missing"), player);
+            // Di bawah root, move PV adalah move TT generasi ini; berhenti di node yang tidak tersimpan
+            FMinimaxTTEntry Entry;
+            if (!TranspositionTable.Probe(Key, Entry) || Entry.Generation != TranspositionTable.GetGeneration() || Entry.PackedAction == 0)
+                break;
+            Act = FMinimaxTranspositionTable::DecodeAction(Entry.PackedAction);
         }
 
-        if (P)
+        const uint16 Packed = FMinimaxTranspositionTable::EncodeAction(Act);
+        if (Packed == 0)
+            break;
+
+        // Tabrakan key bisa memberi move yang tidak legal di posisi ini; PV dipotong di situ
+        if (Act.bIsWall)
         {
-            S.WallCounts[idx][0]  = P->GetWallCountOfLength(1);
-            S.WallCounts[idx][1]  = P->GetWallCountOfLength(2);
-            S.WallCounts[idx][2]  = P->GetWallCountOfLength(3);
-            S.WallsRemaining[idx] = S.WallCounts[idx][0]
-                                   + S.WallCounts[idx][1]
-                                   + S.WallCounts[idx][2];
+            if (Act.WallLength < 1 || Act.WallLength > 3 || S.WallCounts[Mover - 1][Act.WallLength - 1] <= 0)
+                break;
+            ApplyWall(S, Mover, FWallData{ Act.SlotX, Act.SlotY, Act.WallLength, Act.bHorizontal });
         }
         else
         {
-            S.WallCounts[idx][0]  = 0;
-            S.WallCounts[idx][1]  = 0;
-            S.WallCounts[idx][2]  = 0;
-            S.WallsRemaining[idx] = 0;
+            if (!GetPawnMoves(S, Mover).Contains(FIntPoint(Act.MoveX, Act.MoveY)))
+                break;
+            ApplyPawnMove(S, Mover, Act.MoveX, Act.MoveY);
         }
+
+        PreviousPV.Add(TPair<uint64, uint16>(Key, Packed));
+        Mover = 3 - Mover;
     }
+}
 
-    // 3) Horizontal slots → HorizontalBlocked
-    for (AWallSlot* Slot : Board->HorizontalWallSlots)
+void MinimaxEngine::SeedPreviousPrincipalVariation()
+{
+    // Setelah dua ply dimainkan sesuai prediksi, node PV[2..] ada di pohon search baru dengan key yang sama;
+    // node yang tidak lagi tercapai hanya memakan slot sampai tertimpa
+    for (const TPair<uint64, uint16>& Node : PreviousPV)
     {
-        if (!Slot || !Slot->bIsOccupied)
-            continue;
-
-        int slotX = Slot->GridX;  // expected 0..8
-        int slotY = Slot->GridY;  // expected 0..7
-
-        if (slotX < 0 || slotX > 8 || slotY < 0 || slotY > 7)
-            continue;
-
-        // Block two adjacent horizontal edges
-        S.HorizontalBlocked[slotY][slotX] = true;
-
-        UE_LOG(LogTemp, Warning,
-            TEXT("FromBoard: Mapped H‐Wall @ (X=%d, Y=%d)"),
-            slotX, slotY);
+        TranspositionTable.Store(Node.Key, 0, 0, EMinimaxBound::None, Node.Value);
     }
+}
 
 
-    // 4) Vertical slots → VerticalBlocked
-    for (AWallSlot* Slot : Board->VerticalWallSlots)
+//-----------------------------------------------------------------------------
+// FMinimaxState::FromBoard (bener)
+//-----------------------------------------------------------------------------
+FMinimaxState FMinimaxState::FromBoard(AQuoridorBoard* Board)
+{
+    // Board memelihara model ini secara incremental (SpawnPawn, MoveToTile, TryPlaceWall,
+    // ForcePlaceWallForAI), jadi snapshot cukup berupa copy biasa
+    if (!Board)
     {
-        if (!Slot || !Slot->bIsOccupied)
-            continue;
-
-        int slotX = Slot->GridX;  // expected 0..7
-        int slotY = Slot->GridY;  // expected 0..8
-
-        if (slotX < 0 || slotX > 7 || slotY < 0 || slotY > 8)
+        UE_LOG(LogTemp, Error, TEXT("FromBoard: Board is null"));
+        FMinimaxState Empty = FMinimaxState();
+        for (int idx = 0; idx < 2; ++idx)
         {
-            UE_LOG(LogTemp, Warning,
-                TEXT("FromBoard: Skipping V‐Wall @ (X=%d, Y=%d) because out of range"), 
-                slotX, slotY);
-            continue;
+            Empty.PawnX[idx] = -1;
+            Empty.PawnY[idx] = -1;
         }
+        return Empty;
+    }
 
-        // Block two adjacent vertical edges
-        S.VerticalBlocked[slotY][slotX] = true;
+    return Board->GetBoardModel();
+}
 
-        UE_LOG(LogTemp, Warning,
-            TEXT("FromBoard: Mapped V‐Wall @ (X=%d, Y=%d)"),
-            slotX, slotY);
+bool FMinimaxState::HasSamePosition(const FMinimaxState& Other) const
+{
+    for (int32 idx = 0; idx < 2; ++idx)
+    {
+        if (PawnX[idx] != Other.PawnX[idx] || PawnY[idx] != Other.PawnY[idx] ||
+            WallsRemaining[idx] != Other.WallsRemaining[idx] ||
+            LastPawnPos[idx] != Other.LastPawnPos[idx] ||
+            SecondLastPawnPos[idx] != Other.SecondLastPawnPos[idx])
+        {
+            return false;
+        }
     }
 
-
-    return S;
+    return FMemory::Memcmp(WallCounts, Other.WallCounts, sizeof(WallCounts)) == 0 &&
+           FMemory::Memcmp(HorizontalBlocked, Other.HorizontalBlocked, sizeof(HorizontalBlocked)) == 0 &&
+           FMemory::Memcmp(VerticalBlocked, Other.VerticalBlocked, sizeof(VerticalBlocked)) == 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -343,6 +560,29 @@ bool MinimaxEngine::IsWallPlacementStrictlyLegal(const FMinimaxState& S,const FW
     return true;
 }
 
+//-----------------------------------------------------------------------------
+// Legalitas satu aksi (pawn move atau wall lengkap dengan cek path)
+//-----------------------------------------------------------------------------
+bool MinimaxEngine::IsActionLegal(const FMinimaxState& S, int32 PlayerNum, const FMinimaxAction& Act)
+{
+    if (PlayerNum < 1 || PlayerNum > 2)
+        return false;
+
+    if (!Act.bIsWall)
+        return GetPawnMoves(S, PlayerNum).Contains(FIntPoint(Act.MoveX, Act.MoveY));
+
+    if (Act.WallLength < 1 || Act.WallLength > 3 || S.WallCounts[PlayerNum - 1][Act.WallLength - 1] <= 0)
+        return false;
+
+    const FWallData W{ Act.SlotX, Act.SlotY, Act.WallLength, Act.bHorizontal };
+    if (!IsWallPlacementStrictlyLegal(S, W))
+        return false;
+
+    FMinimaxState TempState = S;
+    ApplyWall(TempState, PlayerNum, W);
+    return !DoesWallBlockPlayer(TempState);
+}
+
 //-----------------------------------------------------------------------------
 // Check if wall blocks a player(bener)
 //-----------------------------------------------------------------------------
@@ -682,63 +922,197 @@ TArray<FIntPoint> MinimaxEngine::GetPawnMoves(const FMinimaxState& S, int32 Play
 }
 
 //-----------------------------------------------------------------------------
-// Board Control Heuristic( ga tau ke pake atau ga)
+// Goal Distances (BFS mundur dari baris tujuan, pawn diabaikan)
+//-----------------------------------------------------------------------------
+void MinimaxEngine::ComputeGoalDistances(const FMinimaxState& S, int32 PlayerNum, int32 OutDist[9][9])
+{
+    const int goalY = (PlayerNum == 1 ? 8 : 0);
+
+    for (int y = 0; y < 9; ++y)
+        for (int x = 0; x < 9; ++x)
+            OutDist[y][x] = 100;
+
+    // Fixed-size ring buffer, every tile is enqueued at most once
+    FIntPoint Queue[81];
+    int Head = 0, Tail = 0;
+
+    for (int x = 0; x < 9; ++x)
+    {
+        OutDist[goalY][x] = 0;
+        Queue[Tail++] = FIntPoint(x, goalY);
+    }
+
+    while (Head < Tail)
+    {
+        const FIntPoint c = Queue[Head++];
+        const int d = OutDist[c.Y][c.X] + 1;
+
+        // Right / Left / Down / Up, same edge rules as ComputePathToGoal
+        if (c.X < 8 && !S.VerticalBlocked[c.Y][c.X] && OutDist[c.Y][c.X + 1] > d)
+        {
+            OutDist[c.Y][c.X + 1] = d;
+            Queue[Tail++] = FIntPoint(c.X + 1, c.Y);
+        }
+        if (c.X > 0 && !S.VerticalBlocked[c.Y][c.X - 1] && OutDist[c.Y][c.X - 1] > d)
+        {
+            OutDist[c.Y][c.X - 1] = d;
+            Queue[Tail++] = FIntPoint(c.X - 1, c.Y);
+        }
+        if (c.Y < 8 && !S.HorizontalBlocked[c.Y][c.X] && OutDist[c.Y + 1][c.X] > d)
+        {
+            OutDist[c.Y + 1][c.X] = d;
+            Queue[Tail++] = FIntPoint(c.X, c.Y + 1);
+        }
+        if (c.Y > 0 && !S.HorizontalBlocked[c.Y - 1][c.X] && OutDist[c.Y - 1][c.X] > d)
+        {
+            OutDist[c.Y - 1][c.X] = d;
+            Queue[Tail++] = FIntPoint(c.X, c.Y - 1);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Shortest-Path Pawn Moves (buat pemain yang wall-nya sudah habis)
+//-----------------------------------------------------------------------------
+TArray<FIntPoint> MinimaxEngine::GetShortestPathPawnMoves(const FMinimaxState& S, int32 PlayerNum)
+{
+    TArray<FIntPoint> Moves = GetPawnMoves(S, PlayerNum);
+    if (Moves.Num() <= 1)
+        return Moves;
+
+    int32 Dist[9][9];
+    ComputeGoalDistances(S, PlayerNum, Dist);
+
+    int32 BestDist = INT_MAX;
+    for (const FIntPoint& mv : Moves)
+        BestDist = FMath::Min(BestDist, Dist[mv.Y][mv.X]);
+
+    TArray<FIntPoint> Out;
+    Out.Reserve(Moves.Num());
+    for (const FIntPoint& mv : Moves)
+    {
+        if (Dist[mv.Y][mv.X] == BestDist)
+            Out.Add(mv);
+    }
+    return Out;
+}
+
+//-----------------------------------------------------------------------------
+// FBoardMask - 81-bit tile set (bit = Y * 9 + X) split over two words
+//-----------------------------------------------------------------------------
+struct FBoardMask
+{
+    uint64 Lo = 0; // tiles 0..63
+    uint64 Hi = 0; // tiles 64..80
+
+    static constexpr uint64 HiMask = (1ull << 17) - 1;
+
+    static FBoardMask FromBits(const uint64 Bits[2])
+    {
+        FBoardMask M;
+        M.Lo = Bits[0];
+        M.Hi = Bits[1] & HiMask;
+        return M;
+    }
+
+    static FBoardMask Tile(int32 X, int32 Y)
+    {
+        FBoardMask M;
+        const int32 Bit = Y * 9 + X;
+        if (Bit < 64) M.Lo = 1ull << Bit;
+        else          M.Hi = 1ull << (Bit - 64);
+        return M;
+    }
+
+    bool IsEmpty() const { return (Lo | Hi) == 0; }
+    int32 Count() const { return FMath::CountBits(Lo) + FMath::CountBits(Hi); }
+
+    FBoardMask operator|(const FBoardMask& O) const { FBoardMask M; M.Lo = Lo | O.Lo; M.Hi = Hi | O.Hi; return M; }
+    FBoardMask operator&(const FBoardMask& O) const { FBoardMask M; M.Lo = Lo & O.Lo; M.Hi = Hi & O.Hi; return M; }
+    FBoardMask operator~() const { FBoardMask M; M.Lo = ~Lo; M.Hi = ~Hi & HiMask; return M; }
+    FBoardMask& operator|=(const FBoardMask& O) { Lo |= O.Lo; Hi |= O.Hi; return *this; }
+
+    // N < 64
+    FBoardMask operator<<(int32 N) const { FBoardMask M; M.Lo = Lo << N; M.Hi = ((Hi << N) | (Lo >> (64 - N))) & HiMask; return M; }
+    FBoardMask operator>>(int32 N) const { FBoardMask M; M.Lo = (Lo >> N) | (Hi << (64 - N)); M.Hi = Hi >> N; return M; }
+};
+
+// Tile yang punya tetangga ke tiap arah (tepi papan saja); konstan, jadi dibangun sekali
+struct FBoardEdgeMasks
+{
+    FBoardMask HasEast, HasWest, HasNorth, HasSouth;
+
+    FBoardEdgeMasks()
+    {
+        for (int32 y = 0; y < 9; ++y)
+        {
+            for (int32 x = 0; x < 9; ++x)
+            {
+                const FBoardMask T = FBoardMask::Tile(x, y);
+                if (x < 8) HasEast  |= T;
+                if (x > 0) HasWest  |= T;
+                if (y < 8) HasNorth |= T;
+                if (y > 0) HasSouth |= T;
+            }
+        }
+    }
+};
+
+//-----------------------------------------------------------------------------
+// Board Control Heuristic (Voronoi): dilasi bersamaan dari kedua pawn,
+// tile yang dicapai kedua pemain di langkah yang sama dianggap netral
 //-----------------------------------------------------------------------------
 void MinimaxEngine::ComputeBoardControl(const FMinimaxState& S, int32& MyControl, int32& OppControl, int32 RootPlayer)
 {
     MyControl = 0; OppControl = 0;
-    int visited[9][9] = {};
-    std::queue<FIntPoint> q1, q2;
+
+    // Tile yang boleh melangkah ke arah tertentu (wall + tepi papan). VerticalBlocked[y][x] menutup
+    // sisi timur tile (x,y) dan sisi barat (x+1,y); HorizontalBlocked[y][x] sisi utara (x,y) dan selatan (x,y+1)
+    static const FBoardEdgeMasks Edges;
+    const FBoardMask VBlock = FBoardMask::FromBits(S.VerticalBlockedBits);
+    const FBoardMask HBlock = FBoardMask::FromBits(S.HorizontalBlockedBits);
+    const FBoardMask CanEast  = Edges.HasEast  & ~VBlock;
+    const FBoardMask CanWest  = Edges.HasWest  & ~(VBlock << 1);
+    const FBoardMask CanNorth = Edges.HasNorth & ~HBlock;
+    const FBoardMask CanSouth = Edges.HasSouth & ~(HBlock << 9);
+
+    auto Dilate = [&](const FBoardMask& F) -> FBoardMask
+    {
+        return ((F & CanEast) << 1) | ((F & CanWest) >> 1) | ((F & CanNorth) << 9) | ((F & CanSouth) >> 9);
+    };
 
     int idxAI = RootPlayer - 1;
     int idxOpponent = 1 - idxAI;
 
-    int ax = S.PawnX[idxAI], ay = S.PawnY[idxAI];
-    int bx = S.PawnX[idxOpponent], by = S.PawnY[idxOpponent];
+    FBoardMask Mine, Theirs;
+    if (S.PawnX[idxAI] >= 0 && S.PawnY[idxAI] >= 0)
+        Mine = FBoardMask::Tile(S.PawnX[idxAI], S.PawnY[idxAI]);
+    if (S.PawnX[idxOpponent] >= 0 && S.PawnY[idxOpponent] >= 0)
+        Theirs = FBoardMask::Tile(S.PawnX[idxOpponent], S.PawnY[idxOpponent]);
 
-    if (ay >= 0 && ax >= 0) { visited[ay][ax] = RootPlayer; q1.push({ax, ay}); MyControl++; }
-    if (by >= 0 && bx >= 0) { visited[by][bx] = 3 - RootPlayer; q2.push({bx, by}); OppControl++; }
+    FBoardMask Claimed = Mine | Theirs;
+    FBoardMask MyFrontier = Mine, OppFrontier = Theirs;
 
-    auto CanMove = [&](int ax, int ay, int bx, int by) -> bool {
-        if (bx < 0 || bx > 8 || by < 0 || by > 8) return false;
-        if (bx == ax + 1 && ax >= 0 && ax < 8 && S.VerticalBlocked[ay][ax]) return false;
-        if (bx == ax - 1 && bx >= 0 && bx < 8 && S.VerticalBlocked[ay][bx]) return false;
-        if (by == ay + 1 && ay >= 0 && ay < 8 && S.HorizontalBlocked[ay][ax]) return false;
-        if (by == ay - 1 && by >= 0 && by < 8 && S.HorizontalBlocked[by][ax]) return false;
-        return true;
-    };
+    while (!MyFrontier.IsEmpty() || !OppFrontier.IsEmpty())
+    {
+        const FBoardMask Free = ~Claimed;
+        FBoardMask MyGrow  = Dilate(MyFrontier) & Free;
+        FBoardMask OppGrow = Dilate(OppFrontier) & Free;
+        const FBoardMask Contested = MyGrow & OppGrow;
+        const FBoardMask NotContested = ~Contested;
 
-    const FIntPoint dirs[4] = {{1,0}, {-1,0}, {0,1}, {0,-1}};
-
-    while (!q1.empty() || !q2.empty()) {
-        int q1_size = q1.size();
-        for (int i = 0; i < q1_size; ++i) {
-            FIntPoint curr = q1.front(); q1.pop();
-            for (const auto& d : dirs) {
-                int nx = curr.X + d.X;
-                int ny = curr.Y + d.Y;
-                if (nx >= 0 && nx < 9 && ny >= 0 && ny < 9 &&
-                    CanMove(curr.X, curr.Y, nx, ny) && visited[ny][nx] == 0) {
-                    visited[ny][nx] = RootPlayer; MyControl++;
-                    q1.push({nx, ny});
-                }
-            }
-        }
+        MyGrow  = MyGrow & NotContested;
+        OppGrow = OppGrow & NotContested;
+        Claimed |= MyGrow | OppGrow | Contested;
 
-        int q2_size = q2.size();
-        for (int i = 0; i < q2_size; ++i) {
-            FIntPoint curr = q2.front(); q2.pop();
-            for (const auto& d : dirs) {
-                int nx = curr.X + d.X;
-                int ny = curr.Y + d.Y;
-                if (nx >= 0 && nx < 9 && ny >= 0 && ny < 9 &&
-                    CanMove(curr.X, curr.Y, nx, ny) && visited[ny][nx] == 0) {
-                    visited[ny][nx] = 3 - RootPlayer; OppControl++;
-                    q2.push({nx, ny});
-                }
-            }
-        }
+        Mine   |= MyGrow;
+        Theirs |= OppGrow;
+        MyFrontier  = MyGrow;
+        OppFrontier = OppGrow;
     }
+
+    MyControl  = Mine.Count();
+    OppControl = Theirs.Count();
 }
 
 //-----------------------------------------------------------------------------
@@ -762,12 +1136,23 @@ void MinimaxEngine::PrintInventory(const FMinimaxState& S, const FString& Contex
 //-----------------------------------------------------------------------------
 // Evaluate (harus di tweak)
 //-----------------------------------------------------------------------------
-int32 MinimaxEngine::Evaluate(const FMinimaxState& S, int32 RootPlayer, const TArray<FIntPoint>& IdealPath)
+int32 MinimaxEngine::Evaluate(const FMinimaxState& S, int32 RootPlayer, const TArray<FIntPoint>& IdealPath) const
 {
     int idxAI       = RootPlayer - 1;
     int idxOpp      = 1 - idxAI;
     int OpponentNum = 3 - RootPlayer;
     float Score = 0;
+
+    // 0. Learned evaluator: terminal check saja, tanpa pathfinding
+    if (IsLearnedEvaluatorActive())
+    {
+        if (S.PawnY[idxAI] == ((RootPlayer == 1) ? 8 : 0))
+            return 100000;
+        if (S.PawnY[idxOpp] == ((RootPlayer == 1) ? 0 : 8))
+            return -100000;
+        return LearnedEvaluator->Evaluate(S, RootPlayer);
+    }
+
  // 1. Pathfinding normal
     int32 AILen = 0, OppLen = 0;
     TArray<FIntPoint> AIPath  = ComputePathToGoal(S, RootPlayer,   &AILen);
@@ -903,6 +1288,14 @@ int32 MinimaxEngine::Evaluate(const FMinimaxState& S, int32 RootPlayer, const TA
     // Wall inventory advantage
     Score += (S.WallsRemaining[idxAI] - S.WallsRemaining[idxOpp]) * 15;
     Score -= S.WallsRemaining[idxAI] * 3;
+
+    // Territory (Voronoi) advantage
+    if (bUseBoardControlTerm)
+    {
+        int32 MyControl = 0, OppControl = 0;
+        ComputeBoardControl(S, MyControl, OppControl, RootPlayer);
+        Score += (MyControl - OppControl) * BoardControlWeight;
+    }
     
     return Score;
 }
@@ -912,7 +1305,7 @@ int32 MinimaxEngine::Evaluate(const FMinimaxState& S, int32 RootPlayer, const TA
 //-----------------------------------------------------------------------------
 // Apply Pawn Move ( harus nya bener )
 //-----------------------------------------------------------------------------
-void MinimaxEngine::ApplyPawnMove(FMinimaxState& S, int32 PlayerNum, int32 X, int32 Y)
+void MinimaxEngine::ApplyPawnMove(FMinimaxState& S, int32 PlayerNum, int32 X, int32 Y, const FMinimaxNNUE* Network)
 {
     int idx = PlayerNum - 1;
 
@@ -920,6 +1313,16 @@ void MinimaxEngine::ApplyPawnMove(FMinimaxState& S, int32 PlayerNum, int32 X, in
     S.SecondLastPawnPos[idx] = S.LastPawnPos[idx];
     S.LastPawnPos[idx] = FIntPoint(S.PawnX[idx], S.PawnY[idx]);
 
+    if (S.Accumulator.bValid && Network)
+    {
+        Network->RemoveFeature(S.Accumulator, FMinimaxNNUE::PawnFeature(idx, S.PawnX[idx], S.PawnY[idx]));
+        Network->AddFeature(S.Accumulator, FMinimaxNNUE::PawnFeature(idx, X, Y));
+    }
+    else
+    {
+        S.Accumulator.bValid = false;
+    }
+
     // Update current position
     S.PawnX[idx] = X;
     S.PawnY[idx] = Y;
@@ -929,7 +1332,7 @@ void MinimaxEngine::ApplyPawnMove(FMinimaxState& S, int32 PlayerNum, int32 X, in
 //-----------------------------------------------------------------------------
 // Apply Wall (Updated for WallCounts & Length)
 //-----------------------------------------------------------------------------
-void MinimaxEngine::ApplyWall(FMinimaxState& S, int32 PlayerNum, const FWallData& W)
+void MinimaxEngine::ApplyWall(FMinimaxState& S, int32 PlayerNum, const FWallData& W, const FMinimaxNNUE* Network)
 {
     int idx = PlayerNum - 1;
 
@@ -944,6 +1347,8 @@ void MinimaxEngine::ApplyWall(FMinimaxState& S, int32 PlayerNum, const FWallData
     // *** End check ***
 
     int lenIdx = W.Length - 1; // maps 1→0, 2→1, 3→2
+    const bool bTrackAccumulator = S.Accumulator.bValid && Network;
+    S.Accumulator.bValid = bTrackAccumulator;
 
     // --- Apply each segment of the wall ---
     for (int i = 0; i < W.Length; ++i)
@@ -957,7 +1362,10 @@ void MinimaxEngine::ApplyWall(FMinimaxState& S, int32 PlayerNum, const FWallData
             //    0 ≤ cy < 8   and   0 ≤ cx < 9
             if (cy >= 0 && cy < 8 && cx >= 0 && cx < 9)
             {
+                if (bTrackAccumulator && !S.HorizontalBlocked[cy][cx])
+                    Network->AddFeature(S.Accumulator, FMinimaxNNUE::HorizontalFeature(cx, cy));
                 S.HorizontalBlocked[cy][cx] = true;
+                S.HorizontalBlockedBits[(cy * 9 + cx) >> 6] |= 1ull << ((cy * 9 + cx) & 63);
             }
             else
             {
@@ -973,7 +1381,10 @@ void MinimaxEngine::ApplyWall(FMinimaxState& S, int32 PlayerNum, const FWallData
             //    0 ≤ cy < 9   and   0 ≤ cx < 8
             if (cy >= 0 && cy < 9 && cx >= 0 && cx < 8)
             {
+                if (bTrackAccumulator && !S.VerticalBlocked[cy][cx])
+                    Network->AddFeature(S.Accumulator, FMinimaxNNUE::VerticalFeature(cx, cy));
                 S.VerticalBlocked[cy][cx] = true;
+                S.VerticalBlockedBits[(cy * 9 + cx) >> 6] |= 1ull << ((cy * 9 + cx) & 63);
             }
             else
             {
@@ -988,6 +1399,11 @@ void MinimaxEngine::ApplyWall(FMinimaxState& S, int32 PlayerNum, const FWallData
     // --- Update counts (we know lenIdx is 0,1,2) ---
     if (S.WallCounts[idx][lenIdx] > 0)
     {
+        if (bTrackAccumulator)
+        {
+            Network->RemoveFeature(S.Accumulator, FMinimaxNNUE::InventoryFeature(idx, W.Length, S.WallCounts[idx][lenIdx]));
+            Network->AddFeature(S.Accumulator, FMinimaxNNUE::InventoryFeature(idx, W.Length, S.WallCounts[idx][lenIdx] - 1));
+        }
         S.WallCounts[idx][lenIdx]--;
         S.WallsRemaining[idx]--;
     }
@@ -1004,8 +1420,12 @@ void MinimaxEngine::ApplyWall(FMinimaxState& S, int32 PlayerNum, const FWallData
 //-----------------------------------------------------------------------------
 // Max_Minimax
 //-----------------------------------------------------------------------------
-FMinimaxResult MinimaxEngine::Max_Minimax(const FMinimaxState& S,int32 Depth,int32 RootPlayer, int32 currturn,  const TArray<FIntPoint>& IdealPath)
+FMinimaxResult MinimaxEngine::Max_Minimax(const FMinimaxState& S,int32 Depth,int32 RootPlayer, int32 currturn,  const TArray<FIntPoint>& IdealPath, const FMinimaxStopToken* Stop)
 {
+    if (IsSearchStopped(Stop))
+        return FMinimaxResult();
+    ++NodesSearched;
+
     const int idxAI       = RootPlayer - 1;
     const int idxOpp      = 2 - RootPlayer;
     const int OpponentNum = 3 - RootPlayer;
@@ -1101,6 +1521,8 @@ FMinimaxResult MinimaxEngine::Max_Minimax(const FMinimaxState& S,int32 Depth,int
     // });
     for (int32 i = 0; i < Candidates.Num(); ++i)
     {
+        if (IsSearchStopped(Stop))
+            break;
         // UE_LOG(LogTemp, Warning, TEXT("IN Max_Minimax"));
         const FMinimaxAction& act = Candidates[i];
         FMinimaxState SS = S;
@@ -1115,15 +1537,17 @@ FMinimaxResult MinimaxEngine::Max_Minimax(const FMinimaxState& S,int32 Depth,int
             {
                 continue; // Ganti return; menjadi continue; pada loop biasa
             }
-            ApplyWall(SS, RootPlayer, w);
+            ApplyWall(SS, RootPlayer, w, GetActiveEvaluator());
         }
         else
         {
-            ApplyPawnMove(SS, RootPlayer, act.MoveX, act.MoveY);
+            ApplyPawnMove(SS, RootPlayer, act.MoveX, act.MoveY, GetActiveEvaluator());
         }
     
-        FMinimaxResult subResult = Min_Minimax(SS, Depth - 1, OpponentNum, currturn, IdealPath);
+        FMinimaxResult subResult = Min_Minimax(SS, Depth - 1, OpponentNum, currturn, IdealPath, Stop);
         int32 v = subResult.BestValue;
+        if (Depth == CurrentRootDepth)
+            ReportRootMove(act, v, Stop);
     
         // 4.c) Update bestValue (cari nilai tertinggi)
         if (v > bestValue)  
@@ -1226,8 +1650,12 @@ FMinimaxResult MinimaxEngine::Max_Minimax(const FMinimaxState& S,int32 Depth,int
 //-----------------------------------------------------------------------------
 // Min_Minimax 
 //-----------------------------------------------------------------------------
-FMinimaxResult MinimaxEngine::Min_Minimax(const FMinimaxState& S,int32 Depth,int32 RootPlayer, int32 currturn,  const TArray<FIntPoint>& IdealPath)
+FMinimaxResult MinimaxEngine::Min_Minimax(const FMinimaxState& S,int32 Depth,int32 RootPlayer, int32 currturn,  const TArray<FIntPoint>& IdealPath, const FMinimaxStopToken* Stop)
 {
+    if (IsSearchStopped(Stop))
+        return FMinimaxResult();
+    ++NodesSearched;
+
     const int idxAI       = RootPlayer - 1;
     const int idxOpp      = 2 - RootPlayer;
     const int OpponentNum = 3 - RootPlayer;
@@ -1320,6 +1748,8 @@ FMinimaxResult MinimaxEngine::Min_Minimax(const FMinimaxState& S,int32 Depth,int
     // });
     for (int32 i = 0; i < Candidates.Num(); ++i)
     {
+        if (IsSearchStopped(Stop))
+            break;
         // UE_LOG(LogTemp, Warning, TEXT("IN Min_Minimax"));
         const FMinimaxAction& act = Candidates[i];
         FMinimaxState SS = S;
@@ -1334,14 +1764,14 @@ FMinimaxResult MinimaxEngine::Min_Minimax(const FMinimaxState& S,int32 Depth,int
             {
                 continue; // Ganti return; menjadi continue; pada loop biasa
             }
-            ApplyWall(SS, RootPlayer, w);
+            ApplyWall(SS, RootPlayer, w, GetActiveEvaluator());
         }
         else
         {
-            ApplyPawnMove(SS, RootPlayer, act.MoveX, act.MoveY);
+            ApplyPawnMove(SS, RootPlayer, act.MoveX, act.MoveY, GetActiveEvaluator());
         }
 
-        FMinimaxResult subResult = Max_Minimax(SS, Depth - 1, OpponentNum, currturn, IdealPath);
+        FMinimaxResult subResult = Max_Minimax(SS, Depth - 1, OpponentNum, currturn, IdealPath, Stop);
         int32 v = subResult.BestValue;
 
         // 4.c) Update bestValue (cari nilai terendah)
@@ -1393,8 +1823,12 @@ FMinimaxResult MinimaxEngine::Min_Minimax(const FMinimaxState& S,int32 Depth,int
 //-----------------------------------------------------------------------------
 // Max_ParallelMinimax
 //-----------------------------------------------------------------------------
-FMinimaxResult MinimaxEngine::Max_ParallelMinimax(const FMinimaxState& S,int32 Depth,int32 RootPlayer, int32 currturn, const TArray<FIntPoint>& IdealPath)
+FMinimaxResult MinimaxEngine::Max_ParallelMinimax(const FMinimaxState& S,int32 Depth,int32 RootPlayer, int32 currturn, const TArray<FIntPoint>& IdealPath, const FMinimaxStopToken* Stop)
 {
+    if (IsSearchStopped(Stop))
+        return FMinimaxResult();
+    ++NodesSearched;
+
     const int idxAI       = RootPlayer - 1;
     const int idxOpp      = 2 - RootPlayer;
     const int OpponentNum = 3 - RootPlayer;
@@ -1463,8 +1897,10 @@ FMinimaxResult MinimaxEngine::Max_ParallelMinimax(const FMinimaxState& S,int32 D
     }
 
     // 4) ParallelFor: evaluasi setiap candidate
-     ParallelFor(Candidates.Num(), [&](int32 i)
+     ParallelForCapped(Candidates.Num(), [&](int32 i)
      {
+         if (IsSearchStopped(Stop))
+             return;
          // UE_LOG(LogTemp, Warning, TEXT("IN Max_ParallelMinimax"));
          const FMinimaxAction& act = Candidates[i];
          FMinimaxState SS = S;
@@ -1482,16 +1918,18 @@ FMinimaxResult MinimaxEngine::Max_ParallelMinimax(const FMinimaxState& S,int32 D
                  return;
              }
     
-             ApplyWall(SS, RootPlayer, w);
+             ApplyWall(SS, RootPlayer, w, GetActiveEvaluator());
          }
          else
          {
-             ApplyPawnMove(SS, RootPlayer, act.MoveX, act.MoveY);
+             ApplyPawnMove(SS, RootPlayer, act.MoveX, act.MoveY, GetActiveEvaluator());
          }
          
          // Panggil Min_ParallelMinimax (karena selanjutnya kita cari nilai minimum)
-         FMinimaxResult subResult = Min_ParallelMinimax(SS, Depth - 1, OpponentNum, currturn, IdealPath);
+         FMinimaxResult subResult = Min_ParallelMinimax(SS, Depth - 1, OpponentNum, currturn, IdealPath, Stop);
          int32 v = subResult.BestValue;
+         if (Depth == CurrentRootDepth)
+             ReportRootMove(act, v, Stop);
     
          // 4.c) Update bestValue & bestAction secara thread‐safe
          {
@@ -1598,8 +2036,12 @@ FMinimaxResult MinimaxEngine::Max_ParallelMinimax(const FMinimaxState& S,int32 D
 //-----------------------------------------------------------------------------
 // Min_ParallelMinimax 
 //-----------------------------------------------------------------------------
-FMinimaxResult MinimaxEngine::Min_ParallelMinimax(const FMinimaxState& S,int32 Depth,int32 RootPlayer,int32 currturn, const TArray<FIntPoint>& IdealPath)
+FMinimaxResult MinimaxEngine::Min_ParallelMinimax(const FMinimaxState& S,int32 Depth,int32 RootPlayer,int32 currturn, const TArray<FIntPoint>& IdealPath, const FMinimaxStopToken* Stop)
 {
+    if (IsSearchStopped(Stop))
+        return FMinimaxResult();
+    ++NodesSearched;
+
     const int idxAI       = RootPlayer - 1;
     const int idxOpp      = 2 - RootPlayer;
     const int OpponentNum = 3 - RootPlayer;
@@ -1657,8 +2099,10 @@ FMinimaxResult MinimaxEngine::Min_ParallelMinimax(const FMinimaxState& S,int32 D
     }
 
     // 4) ParallelFor: evaluasi setiap candidate
-    ParallelFor(Candidates.Num(), [&](int32 i)
+    ParallelForCapped(Candidates.Num(), [&](int32 i)
     {
+        if (IsSearchStopped(Stop))
+            return;
         // UE_LOG(LogTemp, Warning, TEXT("IN Min_ParallelMinimax"));
         const FMinimaxAction& act = Candidates[i];
         FMinimaxState SS = S;
@@ -1673,15 +2117,15 @@ FMinimaxResult MinimaxEngine::Min_ParallelMinimax(const FMinimaxState& S,int32 D
             {
                 return;
             }
-            ApplyWall(SS, RootPlayer, w);
+            ApplyWall(SS, RootPlayer, w, GetActiveEvaluator());
         }
         else
         {
-            ApplyPawnMove(SS, RootPlayer, act.MoveX, act.MoveY);
+            ApplyPawnMove(SS, RootPlayer, act.MoveX, act.MoveY, GetActiveEvaluator());
         }
         
     
-        FMinimaxResult subResult = Max_ParallelMinimax(SS, Depth - 1, OpponentNum, currturn, IdealPath);
+        FMinimaxResult subResult = Max_ParallelMinimax(SS, Depth - 1, OpponentNum, currturn, IdealPath, Stop);
         int32 v = subResult.BestValue;
     
         // 4.c) Update bestValue (cari nilai terendah) secara thread‐safe
@@ -1738,8 +2182,23 @@ FMinimaxResult MinimaxEngine::Min_ParallelMinimax(const FMinimaxState& S,int32 D
 //-----------------------------------------------------------------------------
 // Max_MinimaxAlphabeta
 //-----------------------------------------------------------------------------
-FMinimaxResult MinimaxEngine::Max_MinimaxAlphaBeta(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 alpha, int32 beta, int32 currturn, const TArray<FIntPoint>& IdealPath)
+FMinimaxResult MinimaxEngine::Max_MinimaxAlphaBeta(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 alpha, int32 beta, int32 currturn, const TArray<FIntPoint>& IdealPath, const FMinimaxStopToken* Stop)
 {
+    if (IsSearchStopped(Stop))
+        return FMinimaxResult();
+    ++NodesSearched;
+
+    // Transposition table: cutoff hanya di bawah root, action-nya tetap dipakai untuk move ordering
+    const uint64 NodeKey = FMinimaxTranspositionTable::HashState(S, RootPlayer, currturn);
+    const int32 AlphaOrig = alpha;
+    uint16 TTPackedAction = 0;
+    if (Depth > 0)
+    {
+        FMinimaxResult TTResult;
+        if (ProbeTranspositionTable(NodeKey, Depth, alpha, beta, TTResult, TTPackedAction) && Depth != CurrentRootDepth)
+            return TTResult;
+    }
+
     const int idxAI       = RootPlayer - 1;
     const int idxOpp      = 2 - RootPlayer;
     const int OpponentNum = 3 - RootPlayer;
@@ -1807,8 +2266,12 @@ FMinimaxResult MinimaxEngine::Max_MinimaxAlphaBeta(const FMinimaxState& S, int32
         }
     }
     
+    OrderCandidates(Candidates, RootPlayer, TTPackedAction);
+
     for (int32 i = 0; i < Candidates.Num(); ++i)
     {
+        if (IsSearchStopped(Stop))
+            break;
         // UE_LOG(LogTemp, Warning, TEXT("IN Max_MinimaxAlphaBeta"));
         const FMinimaxAction& act = Candidates[i];
         FMinimaxState SS = S;
@@ -1823,15 +2286,17 @@ FMinimaxResult MinimaxEngine::Max_MinimaxAlphaBeta(const FMinimaxState& S, int32
             {
                 continue; // Ganti return; menjadi continue; pada loop biasa
             }
-            ApplyWall(SS, RootPlayer, w);
+            ApplyWall(SS, RootPlayer, w, GetActiveEvaluator());
         }
         else
         {
-            ApplyPawnMove(SS, RootPlayer, act.MoveX, act.MoveY);
+            ApplyPawnMove(SS, RootPlayer, act.MoveX, act.MoveY, GetActiveEvaluator());
         }
     
-        FMinimaxResult subResult = Min_MinimaxAlphaBeta(SS, Depth - 1, OpponentNum,alpha,beta, currturn, IdealPath);
+        FMinimaxResult subResult = Min_MinimaxAlphaBeta(SS, Depth - 1, OpponentNum,alpha,beta, currturn, IdealPath, Stop);
         int32 v = subResult.BestValue;
+        if (Depth == CurrentRootDepth)
+            ReportRootMove(act, v, Stop);
     
         // 4.c) Update bestValue (cari nilai tertinggi)
         if (v > bestValue)  
@@ -1898,6 +2363,7 @@ FMinimaxResult MinimaxEngine::Max_MinimaxAlphaBeta(const FMinimaxState& S, int32
             // UE_LOG(LogTemp, Warning, TEXT("   Pruning all further sibling candidates at this level."));
 
             // --- END: MODIFIED CODE ---
+            RecordCutoff(RootPlayer, act, Depth, Stop);
             break;
         }
         
@@ -1992,14 +2458,30 @@ FMinimaxResult MinimaxEngine::Max_MinimaxAlphaBeta(const FMinimaxState& S, int32
     // }
 
     // 5) Setelah parallel selesai, kembalikan action + value
+    StoreTranspositionTable(NodeKey, Depth, AlphaOrig, beta, FMinimaxResult(bestAction, bestValue), Stop);
     return FMinimaxResult(bestAction, bestValue);
 }
 
 //-----------------------------------------------------------------------------
 // Min_MinimaxAlphabeta
 //-----------------------------------------------------------------------------
-FMinimaxResult MinimaxEngine::Min_MinimaxAlphaBeta(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 alpha, int32 beta, int32 currturn, const TArray<FIntPoint>& IdealPath)
+FMinimaxResult MinimaxEngine::Min_MinimaxAlphaBeta(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 alpha, int32 beta, int32 currturn, const TArray<FIntPoint>& IdealPath, const FMinimaxStopToken* Stop)
 {
+    if (IsSearchStopped(Stop))
+        return FMinimaxResult();
+    ++NodesSearched;
+
+    // Transposition table (node Min tidak pernah root)
+    const uint64 NodeKey = FMinimaxTranspositionTable::HashState(S, RootPlayer, currturn);
+    const int32 BetaOrig = beta;
+    uint16 TTPackedAction = 0;
+    if (Depth > 0)
+    {
+        FMinimaxResult TTResult;
+        if (ProbeTranspositionTable(NodeKey, Depth, alpha, beta, TTResult, TTPackedAction))
+            return TTResult;
+    }
+
     const int idxAI       = RootPlayer - 1;
     const int idxOpp      = 2 - RootPlayer;
     const int OpponentNum = 3 - RootPlayer;
@@ -2056,8 +2538,12 @@ FMinimaxResult MinimaxEngine::Min_MinimaxAlphaBeta(const FMinimaxState& S, int32
         }
     }
     
+    OrderCandidates(Candidates, RootPlayer, TTPackedAction);
+
     for (int32 i = 0; i < Candidates.Num(); ++i)
     {
+        if (IsSearchStopped(Stop))
+            break;
         // UE_LOG(LogTemp, Warning, TEXT("IN Min_MinimaxAlphaBeta"));
         const FMinimaxAction& act = Candidates[i];
         FMinimaxState SS = S;
@@ -2072,14 +2558,14 @@ FMinimaxResult MinimaxEngine::Min_MinimaxAlphaBeta(const FMinimaxState& S, int32
             {
                 continue; // Ganti return; menjadi continue; pada loop biasa
             }
-            ApplyWall(SS, RootPlayer, w);
+            ApplyWall(SS, RootPlayer, w, GetActiveEvaluator());
         }
         else
         {
-            ApplyPawnMove(SS, RootPlayer, act.MoveX, act.MoveY);
+            ApplyPawnMove(SS, RootPlayer, act.MoveX, act.MoveY, GetActiveEvaluator());
         }
 
-        FMinimaxResult subResult = Max_MinimaxAlphaBeta(SS, Depth - 1, OpponentNum,alpha,beta, currturn, IdealPath);
+        FMinimaxResult subResult = Max_MinimaxAlphaBeta(SS, Depth - 1, OpponentNum,alpha,beta, currturn, IdealPath, Stop);
         int32 v = subResult.BestValue;
 
         // 4.c) Update bestValue (cari nilai terendah)
@@ -2147,6 +2633,7 @@ FMinimaxResult MinimaxEngine::Min_MinimaxAlphaBeta(const FMinimaxState& S, int32
             // UE_LOG(LogTemp, Warning, TEXT("   Pruning all further sibling candidates at this level."));
 
             // --- END: MODIFIED CODE ---
+            RecordCutoff(RootPlayer, act, Depth, Stop);
             break;
         }
         
@@ -2184,14 +2671,19 @@ FMinimaxResult MinimaxEngine::Min_MinimaxAlphaBeta(const FMinimaxState& S, int32
     //     );
     // }
 
+    StoreTranspositionTable(NodeKey, Depth, alpha, BetaOrig, FMinimaxResult(bestAction, bestValue), Stop);
     return FMinimaxResult(bestAction, bestValue);
 }
 
 //-----------------------------------------------------------------------------
 // Max_ParallelMinimaxAlphabeta
 //-----------------------------------------------------------------------------
-FMinimaxResult MinimaxEngine::Max_ParallelMinimaxAlphaBeta(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 alpha, int32 beta, int32 currturn, const TArray<FIntPoint>& IdealPath)
+FMinimaxResult MinimaxEngine::Max_ParallelMinimaxAlphaBeta(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 alpha, int32 beta, int32 currturn, const TArray<FIntPoint>& IdealPath, const FMinimaxStopToken* Stop)
 {
+    if (IsSearchStopped(Stop))
+        return FMinimaxResult();
+    ++NodesSearched;
+
     const int idxAI       = RootPlayer - 1;
     const int idxOpp      = 2 - RootPlayer;
     const int OpponentNum = 3 - RootPlayer;
@@ -2263,8 +2755,10 @@ FMinimaxResult MinimaxEngine::Max_ParallelMinimaxAlphaBeta(const FMinimaxState&
     RootResults.SetNum(Candidates.Num());
 
     // 4) ParallelFor: evaluasi setiap candidate
-    ParallelFor(Candidates.Num(), [&](int32 i)
+    ParallelForCapped(Candidates.Num(), [&](int32 i)
     {
+        if (IsSearchStopped(Stop))
+            return;
         // UE_LOG(LogTemp, Warning, TEXT("IN Min_ParallelMinimaxAlphaBeta"));
         const FMinimaxAction& act = Candidates[i];
         FMinimaxState SS = S;
@@ -2279,15 +2773,17 @@ FMinimaxResult MinimaxEngine::Max_ParallelMinimaxAlphaBeta(const FMinimaxState&
             {
                 return;
             }
-            ApplyWall(SS, RootPlayer, w);
+            ApplyWall(SS, RootPlayer, w, GetActiveEvaluator());
         }
         else
         {
-            ApplyPawnMove(SS, RootPlayer, act.MoveX, act.MoveY);
+            ApplyPawnMove(SS, RootPlayer, act.MoveX, act.MoveY, GetActiveEvaluator());
         }
         
     
-        RootResults[i] = Min_MinimaxAlphaBeta(SS, Depth - 1, OpponentNum,alpha,beta, currturn, IdealPath);
+        RootResults[i] = Min_MinimaxAlphaBeta(SS, Depth - 1, OpponentNum,alpha,beta, currturn, IdealPath, Stop);
+        if (Depth == CurrentRootDepth)
+            ReportRootMove(act, RootResults[i].BestValue, Stop);
         
             // UE_LOG(LogTemp, Warning, TEXT("out Min_MinimaxAlphaBeta"));
     });
@@ -2553,46 +3049,282 @@ FMinimaxResult MinimaxEngine::Max_ParallelMinimaxAlphaBeta(const FMinimaxState&
 //     return FMinimaxResult(bestAction, bestValue);
 // }
 
+//-----------------------------------------------------------------------------
+// Single-Sided Alpha-Beta (endgame: lawan sudah tidak punya wall)
+//-----------------------------------------------------------------------------
+void MinimaxEngine::GatherSingleSidedCandidates(const FMinimaxState& S, int32 PlayerNum, TArray<FMinimaxAction>& OutCandidates)
+{
+    const int idx = PlayerNum - 1;
+
+    // A side without walls has nothing better to do than walk its shortest path,
+    // so it only gets those successors. The side with walls keeps the full move list.
+    if (S.WallsRemaining[idx] <= 0)
+    {
+        for (const FIntPoint& mv : GetShortestPathPawnMoves(S, PlayerNum))
+            OutCandidates.Add(FMinimaxAction(mv.X, mv.Y));
+        return;
+    }
+
+    for (const FIntPoint& mv : GetPawnMoves(S, PlayerNum))
+        OutCandidates.Add(FMinimaxAction(mv.X, mv.Y));
+
+    for (const FWallData& w : GetAllUsefulWallPlacements(S, PlayerNum))
+        OutCandidates.Add(FMinimaxAction(w.X, w.Y, w.Length, w.bHorizontal));
+}
+
+FMinimaxResult MinimaxEngine::Max_SingleSidedAlphaBeta(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 alpha, int32 beta, int32 currturn, const TArray<FIntPoint>& IdealPath, const FMinimaxStopToken* Stop)
+{
+    if (IsSearchStopped(Stop))
+        return FMinimaxResult();
+    ++NodesSearched;
+
+    // Transposition table: cutoff hanya di bawah root, action-nya tetap dipakai untuk move ordering
+    const uint64 NodeKey = FMinimaxTranspositionTable::HashState(S, RootPlayer, currturn);
+    const int32 AlphaOrig = alpha;
+    uint16 TTPackedAction = 0;
+    if (Depth > 0)
+    {
+        FMinimaxResult TTResult;
+        if (ProbeTranspositionTable(NodeKey, Depth, alpha, beta, TTResult, TTPackedAction) && Depth != CurrentRootDepth)
+            return TTResult;
+    }
+
+    const int OpponentNum = 3 - RootPlayer;
+
+    int32 AILenCheck = 100;
+    int32 OppLenCheck = 100;
+    ComputePathToGoal(S, RootPlayer,  &AILenCheck);
+    ComputePathToGoal(S, OpponentNum, &OppLenCheck);
+
+    if (Depth == 0 || AILenCheck <= 0 || OppLenCheck <= 0)
+    {
+        return FMinimaxResult(FMinimaxAction(), Evaluate(S, currturn, IdealPath));
+    }
+
+    TArray<FMinimaxAction> Candidates;
+    GatherSingleSidedCandidates(S, RootPlayer, Candidates);
+    OrderCandidates(Candidates, RootPlayer, TTPackedAction);
+
+    if (Candidates.Num() == 0)
+    {
+        return FMinimaxResult(FMinimaxAction(), Evaluate(S, currturn, IdealPath));
+    }
+
+    int32 bestValue = INT_MIN;
+    FMinimaxAction bestAction;
+    TArray<FMinimaxAction> AllMoveActions;
+
+    for (const FMinimaxAction& act : Candidates)
+    {
+        if (IsSearchStopped(Stop))
+            break;
+        FMinimaxState SS = S;
+
+        if (act.bIsWall)
+        {
+            FWallData w{ act.SlotX, act.SlotY, act.WallLength, act.bHorizontal };
+            ApplyWall(SS, RootPlayer, w, GetActiveEvaluator());
+            if (DoesWallBlockPlayer(SS))
+                continue;
+        }
+        else
+        {
+            ApplyPawnMove(SS, RootPlayer, act.MoveX, act.MoveY, GetActiveEvaluator());
+            AllMoveActions.Add(act);
+        }
+
+        const int32 v = Min_SingleSidedAlphaBeta(SS, Depth - 1, OpponentNum, alpha, beta, currturn, IdealPath, Stop).BestValue;
+        if (Depth == CurrentRootDepth)
+            ReportRootMove(act, v, Stop);
+
+        if (v > bestValue)
+        {
+            bestValue = v;
+            bestAction = act;
+        }
+        alpha = FMath::Max(alpha, v);
+
+        if (beta <= alpha)
+        {
+            RecordCutoff(RootPlayer, act, Depth, Stop);
+            break;
+        }
+    }
+
+    // Same tie-break as Max_MinimaxAlphaBeta: a pawn move prefers the next step of IdealPath
+    if (!bestAction.bIsWall && IdealPath.Num() > 1)
+    {
+        const FIntPoint& NextStep = IdealPath[1];
+        for (const FMinimaxAction& Move : AllMoveActions)
+        {
+            if (Move.MoveX == NextStep.X && Move.MoveY == NextStep.Y)
+            {
+                bestAction = Move;
+                break;
+            }
+        }
+    }
+
+    StoreTranspositionTable(NodeKey, Depth, AlphaOrig, beta, FMinimaxResult(bestAction, bestValue), Stop);
+    return FMinimaxResult(bestAction, bestValue);
+}
+
+FMinimaxResult MinimaxEngine::Min_SingleSidedAlphaBeta(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 alpha, int32 beta, int32 currturn, const TArray<FIntPoint>& IdealPath, const FMinimaxStopToken* Stop)
+{
+    if (IsSearchStopped(Stop))
+        return FMinimaxResult();
+    ++NodesSearched;
+
+    // Transposition table (node Min tidak pernah root)
+    const uint64 NodeKey = FMinimaxTranspositionTable::HashState(S, RootPlayer, currturn);
+    const int32 BetaOrig = beta;
+    uint16 TTPackedAction = 0;
+    if (Depth > 0)
+    {
+        FMinimaxResult TTResult;
+        if (ProbeTranspositionTable(NodeKey, Depth, alpha, beta, TTResult, TTPackedAction))
+            return TTResult;
+    }
+
+    const int OpponentNum = 3 - RootPlayer;
+
+    int32 AILenCheck = 100;
+    int32 OppLenCheck = 100;
+    ComputePathToGoal(S, RootPlayer,  &AILenCheck);
+    ComputePathToGoal(S, OpponentNum, &OppLenCheck);
+
+    if (Depth <= 0 || AILenCheck == 0 || OppLenCheck == 0)
+    {
+        return FMinimaxResult(FMinimaxAction(), Evaluate(S, currturn, IdealPath));
+    }
+
+    TArray<FMinimaxAction> Candidates;
+    GatherSingleSidedCandidates(S, RootPlayer, Candidates);
+    OrderCandidates(Candidates, RootPlayer, TTPackedAction);
+
+    if (Candidates.Num() == 0)
+    {
+        return FMinimaxResult(FMinimaxAction(), Evaluate(S, currturn, IdealPath));
+    }
+
+    int32 bestValue = INT_MAX;
+    FMinimaxAction bestAction;
+
+    for (const FMinimaxAction& act : Candidates)
+    {
+        if (IsSearchStopped(Stop))
+            break;
+        FMinimaxState SS = S;
+
+        if (act.bIsWall)
+        {
+            FWallData w{ act.SlotX, act.SlotY, act.WallLength, act.bHorizontal };
+            ApplyWall(SS, RootPlayer, w, GetActiveEvaluator());
+            if (DoesWallBlockPlayer(SS))
+                continue;
+        }
+        else
+        {
+            ApplyPawnMove(SS, RootPlayer, act.MoveX, act.MoveY, GetActiveEvaluator());
+        }
+
+        const int32 v = Max_SingleSidedAlphaBeta(SS, Depth - 1, OpponentNum, alpha, beta, currturn, IdealPath, Stop).BestValue;
+
+        if (v < bestValue)
+        {
+            bestValue = v;
+            bestAction = act;
+        }
+        beta = FMath::Min(beta, v);
+
+        if (beta <= alpha)
+        {
+            RecordCutoff(RootPlayer, act, Depth, Stop);
+            break;
+        }
+    }
+
+    StoreTranspositionTable(NodeKey, Depth, alpha, BetaOrig, FMinimaxResult(bestAction, bestValue), Stop);
+    return FMinimaxResult(bestAction, bestValue);
+}
+
 //-----------------------------------------------------------------------------
 // Run Selected Algo 
 //-----------------------------------------------------------------------------
-FMinimaxResult MinimaxEngine::RunSelectedAlgorithm(const FMinimaxState& Initial,int32 Depth,int32 PlayerTurn,int32 AlgorithmChoice)
+FMinimaxResult MinimaxEngine::RunSelectedAlgorithm(const FMinimaxState& InitialIn,int32 Depth,int32 PlayerTurn,int32 AlgorithmChoice,
+                                                  const FMinimaxStopToken* Stop)
 {
     int32 alpha = INT_MIN;
     int32 beta = INT_MAX;
+
+    // Accumulator di-refresh sekali di root; child state meng-update secara incremental
+    FMinimaxState Initial = InitialIn;
+    if (IsLearnedEvaluatorActive())
+        LearnedEvaluator->RefreshAccumulator(Initial);
+    else
+        Initial.Accumulator.bValid = false;
     TArray<FIntPoint> IdealPath = ComputePathToGoal(Initial, PlayerTurn, nullptr);
+
+    // Nilai di TT hanya berlaku untuk root (IdealPath) dan algoritma yang sama; iterasi
+    // iterative deepening pada root yang sama tetap berbagi generasi
+    const uint64 RootKey = FMinimaxTranspositionTable::HashState(Initial, PlayerTurn, PlayerTurn) ^ (static_cast<uint64>(AlgorithmChoice) << 60);
+    if (RootKey != LastRootKey)
+    {
+        // Root baru: nilai TT root lain tidak berlaku lagi, move-nya (dan PV search terakhir) tetap jadi hint ordering.
+        // History tidak di-age di sini; itu sekali per giliran lewat BeginTurn
+        TranspositionTable.NewGeneration();
+        SeedPreviousPrincipalVariation();
+        LastRootKey = RootKey;
+    }
+    CurrentRootDepth = Depth;
     // UE_LOG(LogTemp, Warning, TEXT("IdealPath untuk Player %d, Length = %d"), PlayerTurn, IdealPath.Num());
     // for (int32 i = 0; i < IdealPath.Num(); ++i)
     // {
     //     UE_LOG(LogTemp, Warning, TEXT("  Path[%d] = (%d,%d)"), i, IdealPath[i].X, IdealPath[i].Y);
     // }
+
+    // Endgame asimetris: lawan sudah kehabisan wall, jadi dia cuma jalan di shortest path-nya.
+    // Ply root tetap ceil(Depth/2) (full-width, termasuk wall); yang ditambah cuma ply lawan
+    // yang branching-nya ~1, jadi Depth ganjil dapat satu balasan lawan ekstra hampir gratis.
+    const int32 OpponentTurn = 3 - PlayerTurn;
+    if (bEnableSingleSidedSearch &&
+        Initial.WallsRemaining[OpponentTurn - 1] == 0 &&
+        Initial.WallsRemaining[PlayerTurn - 1] > 0)
+    {
+        const int32 RootSidePlies = (Depth + 1) / 2;
+        const int32 SingleSidedDepth = FMath::Max(Depth, FMath::Min(RootSidePlies * 2, MaxSingleSidedDepth));
+        CurrentRootDepth = SingleSidedDepth;
+        return FinishRootSearch(Initial, PlayerTurn, Max_SingleSidedAlphaBeta(Initial, SingleSidedDepth, PlayerTurn, alpha, beta, PlayerTurn, IdealPath, Stop), Stop);
+    }
+
+    // Dipanggil per depth (iterative deepening), per ponder dan per baris bench: cukup Verbose
     switch (AlgorithmChoice)
     {
     case 1:
-        UE_LOG(LogTemp, Warning,
+        UE_LOG(LogTemp, Verbose,
             TEXT("RunSelectedAlgorithm: Pilih Plain Parallel Minimax (Choice=1) dengan Depth: %d"), Depth);
-        return Max_Minimax(Initial, Depth, PlayerTurn, PlayerTurn, IdealPath);
+        return FinishRootSearch(Initial, PlayerTurn, Max_Minimax(Initial, Depth, PlayerTurn, PlayerTurn, IdealPath, Stop), Stop);
 
     case 2:
-        UE_LOG(LogTemp, Warning,
+        UE_LOG(LogTemp, Verbose,
             TEXT("RunSelectedAlgorithm: Pilih Parallel Minimax (Choice=2 dengan Depth: %d"), Depth);
         // Ganti dengan pemanggilan fungsi yang sesungguhnya, misalnya:
         // return Max_SerialAlphaBeta(Initial, Depth, PlayerTurn, CurrPlayerTurn);
-        return Max_ParallelMinimax(Initial, Depth, PlayerTurn, PlayerTurn, IdealPath);
+        return FinishRootSearch(Initial, PlayerTurn, Max_ParallelMinimax(Initial, Depth, PlayerTurn, PlayerTurn, IdealPath, Stop), Stop);
 
     case 3:
-        UE_LOG(LogTemp, Warning,
+        UE_LOG(LogTemp, Verbose,
         TEXT("RunSelectedAlgorithm: Pilih Minimax dengan Alpha-Beta (Choice=3) dengan Depth: %d"), Depth);
         // Ganti dengan pemanggilan fungsi yang sesungguhnya, misalnya:
         // return Max_ParallelAlphaBeta(Initial, Depth, PlayerTurn, CurrPlayerTurn);
-        return Max_MinimaxAlphaBeta(Initial, Depth, PlayerTurn,alpha,beta, PlayerTurn, IdealPath);
+        return FinishRootSearch(Initial, PlayerTurn, Max_MinimaxAlphaBeta(Initial, Depth, PlayerTurn,alpha,beta, PlayerTurn, IdealPath, Stop), Stop);
         
     case 4:
-        UE_LOG(LogTemp, Warning,
+        UE_LOG(LogTemp, Verbose,
             TEXT("RunSelectedAlgorithm: Pilih Parallel Minimax dengan Alpha-Beta (Choice=4) dengan Depth: %d"), Depth);
         // Ganti dengan pemanggilan fungsi yang sesungguhnya, misalnya:
         // return Max_ParallelAlphaBeta(Initial, Depth, PlayerTurn, CurrPlayerTurn);
-        return Max_ParallelMinimaxAlphaBeta(Initial, Depth, PlayerTurn,alpha,beta, PlayerTurn, IdealPath);
+        return FinishRootSearch(Initial, PlayerTurn, Max_ParallelMinimaxAlphaBeta(Initial, Depth, PlayerTurn,alpha,beta, PlayerTurn, IdealPath, Stop), Stop);
 
     default:
         UE_LOG(LogTemp, Error,
@@ -2602,6 +3334,63 @@ FMinimaxResult MinimaxEngine::RunSelectedAlgorithm(const FMinimaxState& Initial,
     }
 }
 
+//-----------------------------------------------------------------------------
+// Iterative deepening (time control)
+//-----------------------------------------------------------------------------
+FMinimaxResult MinimaxEngine::RunIterativeDeepening(const FMinimaxState& Initial, int32 MaxDepth, int32 PlayerTurn, int32 AlgorithmChoice,
+                                                    const FMinimaxStopToken* Stop, int32* OutCompletedDepth)
+{
+    FMinimaxResult Best;
+    int32 CompletedDepth = 0;
+    double PrevIterationTime = 0.0;
+    double LastIterationTime = 0.0;
+
+    for (int32 d = 1; d <= FMath::Max(1, MaxDepth); ++d)
+    {
+        // Perkirakan waktu iterasi berikutnya dari rasio dua iterasi terakhir
+        const double Deadline = Stop ? Stop->GetDeadline() : 0.0;
+        if (CompletedDepth >= 2 && Deadline > 0.0 && PrevIterationTime > 0.0)
+        {
+            const double Growth = FMath::Max(2.0, LastIterationTime / PrevIterationTime);
+            if (FPlatformTime::Seconds() + LastIterationTime * Growth > Deadline)
+                break;
+        }
+
+        const double Start = FPlatformTime::Seconds();
+        const FMinimaxResult Result = RunSelectedAlgorithm(Initial, d, PlayerTurn, AlgorithmChoice, Stop);
+        if (IsSearchStopped(Stop))
+            break;
+
+        Best = Result;
+        CompletedDepth = d;
+        PrevIterationTime = LastIterationTime;
+        LastIterationTime = FPlatformTime::Seconds() - Start;
+    }
+
+    // Deadline habis sebelum depth 1 selesai: pakai root move terbaik yang sudah dipublikasikan,
+    // atau jalan satu langkah di shortest path supaya tetap ada aksi legal
+    FMinimaxSearchSnapshot Partial;
+    if (CompletedDepth == 0 && ProgressMailbox && ProgressMailbox->Read(Partial))
+    {
+        Best = FMinimaxResult(Partial.GetBestAction(), Partial.Score);
+        UE_LOG(LogTemp, Warning, TEXT("RunIterativeDeepening: Depth 1 belum selesai, pakai move parsial dari mailbox"));
+    }
+    else if (CompletedDepth == 0)
+    {
+        const TArray<FIntPoint> Path = ComputePathToGoal(Initial, PlayerTurn, nullptr);
+        const TArray<FIntPoint> Moves = GetPawnMoves(Initial, PlayerTurn);
+        if (Path.Num() > 1 && Moves.Contains(Path[1]))
+            Best = FMinimaxResult(FMinimaxAction(Path[1].X, Path[1].Y), 0);
+        else if (Moves.Num() > 0)
+            Best = FMinimaxResult(FMinimaxAction(Moves[0].X, Moves[0].Y), 0);
+        UE_LOG(LogTemp, Warning, TEXT("RunIterativeDeepening: Tidak ada depth yang selesai sebelum deadline, pakai fallback"));
+    }
+
+    if (OutCompletedDepth)
+        *OutCompletedDepth = CompletedDepth;
+    return Best;
+}
+
 
 
 
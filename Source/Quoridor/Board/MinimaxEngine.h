@@ -3,6 +3,9 @@
 #include "CoreMinimal.h"
 #include "Math/UnrealMathUtility.h" // For FIntPoint
 #include "Containers/Array.h"       // For TArray
+#include "MinimaxNNUE.h"
+#include "MinimaxTranspositionTable.h"
+#include "MinimaxSearchProgress.h"
 
 // Forward declare the AQuoridorBoard class to avoid circular dependencies
 class AQuoridorBoard;
@@ -69,8 +72,19 @@ struct FMinimaxState
     bool HorizontalBlocked[8][9]; // [Y][X] - 9 rows, 8 slots per row
     bool VerticalBlocked[9][8];   // [Y][X] - 8 rows, 9 slots per row
 
-    /** Creates a MinimaxState from the current game board */
+    // Wall yang sama dalam bentuk bitboard (bit = Y * 9 + X, [0] = tile 0-63, [1] = tile 64-80),
+    // di-set oleh ApplyWall supaya ComputeBoardControl tidak perlu scan 81 tile per leaf
+    uint64 HorizontalBlockedBits[2];
+    uint64 VerticalBlockedBits[2];
+
+    // First layer of the learned evaluator, kept in sync by ApplyPawnMove / ApplyWall
+    FMinimaxAccumulator Accumulator;
+
+    /** Snapshot of the board's incrementally maintained model (AQuoridorBoard::GetBoardModel) */
     static FMinimaxState FromBoard(AQuoridorBoard* Board);
+
+    /** True jika pion, riwayat pion, wall dan inventory identik (Accumulator diabaikan) */
+    bool HasSamePosition(const FMinimaxState& Other) const;
 };
 
 // Struct untuk menampung hasil Minimax: aksi terbaik + nilai evaluasi
@@ -90,25 +104,92 @@ struct FMinimaxResult
     {}
 };
 
+//-----------------------------------------------------------------------------
+// FMinimaxStopToken - Cooperative cancellation for a running search
+//
+// Game thread memanggil RequestStop (game selesai, level unload, game baru);
+// setiap node search mengecek IsStopRequested dan langsung keluar, jadi
+// search berhenti dalam orde satu evaluasi node. Hasil search yang dihentikan
+// tidak bermakna dan harus dibuang oleh caller.
+//
+// Deadline (FPlatformTime::Seconds) dipakai time control; set sebelum job
+// di-enqueue, setelah itu hanya dibaca oleh search.
+//-----------------------------------------------------------------------------
+struct FMinimaxStopToken
+{
+    void RequestStop() { bStopRequested.Store(true, EMemoryOrder::Relaxed); }
+    bool IsStopRequested() const
+    {
+        return IsCancelled() || (Deadline > 0.0 && FPlatformTime::Seconds() >= Deadline);
+    }
+
+    /** Hanya RequestStop (bukan deadline), termasuk dari Parent: hasil search harus dibuang */
+    bool IsCancelled() const
+    {
+        return bStopRequested.Load(EMemoryOrder::Relaxed) || (Parent && Parent->IsCancelled());
+    }
+
+    void SetDeadline(double InDeadline) { Deadline = InDeadline; }
+    double GetDeadline() const { return Deadline; }
+
+    /** Token per-search (mis. dengan deadline sendiri) yang tetap ikut berhenti saat token job dibatalkan */
+    void SetParent(const FMinimaxStopToken* InParent) { Parent = InParent; }
+
+private:
+    TAtomic<bool> bStopRequested{ false };
+    double Deadline = 0.0; // 0 = tanpa batas waktu
+    const FMinimaxStopToken* Parent = nullptr;
+};
+
+
+/** Counter search sebuah MinimaxEngine sejak ResetStats */
+struct FMinimaxSearchStats
+{
+    int64 NodesSearched = 0;
+    int64 TTProbes = 0;
+    int64 TTHits = 0;
+    int64 TTCutoffs = 0;
+};
 
 //-----------------------------------------------------------------------------
 // MinimaxEngine - Contains the AI logic and search algorithms
+//
+// Satu instance per pemain / per board: instance memiliki transposition table,
+// history table, setting evaluasi, bobot learned evaluator dan counter sendiri,
+// jadi beberapa search (dua AI di AAI_VS_AI, banyak game di commandlet) bisa
+// jalan bersamaan tanpa berbagi state. Satu instance hanya boleh menjalankan
+// satu search dalam satu waktu; ParallelFor di dalam search itu aman.
+//
+// Move generation, pathfinding dan ApplyPawnMove / ApplyWall tetap static
+// karena tidak bergantung pada state instance.
 //-----------------------------------------------------------------------------
 class MinimaxEngine // Or your project's API macro, or remove if not needed
 {
 public:
+    static constexpr int32 DefaultTranspositionTableSizeMB = 16;
+
+    explicit MinimaxEngine(int32 TranspositionTableSizeMB = DefaultTranspositionTableSizeMB);
+    UE_NONCOPYABLE(MinimaxEngine);
 
     // --- Core AI Minimax ---
 
     /** Solves the current state using Minimax with Alpha-Beta Pruning (Recommended) */
-    static FMinimaxAction SolveAlphaBeta(const FMinimaxState& Initial, int32 Depth, int32 RootPlayer);
-    static FMinimaxAction SolveParallelAlphaBeta(const FMinimaxState& Initial, int32 Depth, int32 RootPlayer);
-    static FMinimaxResult RunSelectedAlgorithm(const FMinimaxState& Initial, int32 Depth, int32 PlayerTurn, int32 AlgorithmChoice);
+    FMinimaxAction SolveAlphaBeta(const FMinimaxState& Initial, int32 Depth, int32 RootPlayer);
+    FMinimaxAction SolveParallelAlphaBeta(const FMinimaxState& Initial, int32 Depth, int32 RootPlayer);
+    FMinimaxResult RunSelectedAlgorithm(const FMinimaxState& Initial, int32 Depth, int32 PlayerTurn, int32 AlgorithmChoice,
+                                        const FMinimaxStopToken* Stop = nullptr);
+    /**
+     * Iterative deepening di atas RunSelectedAlgorithm (depth 1..MaxDepth) untuk time control.
+     * Iterasi yang terpotong Stop (deadline / RequestStop) dibuang; hasil depth terakhir yang selesai dipakai.
+     * Iterasi berikutnya dilewati jika perkiraan waktunya (effective branching factor) melewati deadline.
+     */
+    FMinimaxResult RunIterativeDeepening(const FMinimaxState& Initial, int32 MaxDepth, int32 PlayerTurn, int32 AlgorithmChoice,
+                                         const FMinimaxStopToken* Stop, int32* OutCompletedDepth = nullptr);
     /** Solves the current state using Plain Minimax (Very Slow) */
-    static FMinimaxAction Solve(const FMinimaxState& Initial, int32 Depth, int32 RootPlayer); // Can wrap Minimax or AB
+    FMinimaxAction Solve(const FMinimaxState& Initial, int32 Depth, int32 RootPlayer); // Can wrap Minimax or AB
 
     /** Solves the current state using Plain Minimax in Parallel (Still Slow) */
-    static FMinimaxResult SolveParallel(const FMinimaxState& Initial, int32 Depth, int32 RootPlayer);
+    FMinimaxResult SolveParallel(const FMinimaxState& Initial, int32 Depth, int32 RootPlayer);
 
     
     // --- Pathfinding & Evaluation ---
@@ -119,7 +200,7 @@ public:
     static TArray<FIntPoint> ComputePathToGoal(const FMinimaxState& S, int32 PlayerNum, int32* OutLength = nullptr);
 
     /** Evaluates the board state from the perspective of RootPlayer */
-    static int32 Evaluate(const FMinimaxState& S, int32 RootPlayer, const TArray<FIntPoint>& IdealPath);
+    int32 Evaluate(const FMinimaxState& S, int32 RootPlayer, const TArray<FIntPoint>& IdealPath) const;
     static bool FindPathForPawn(const FMinimaxState& S, int32 PlayerNum, TArray<FIntPoint>& OutPath);
 
     // --- Move Generation ---
@@ -129,38 +210,168 @@ public:
 
     /** Gets a scored/filtered list of useful wall placements */
     static TArray<FWallData> GetAllUsefulWallPlacements(const FMinimaxState& S, int32 PlayerNum);
+
+    /** Legal untuk PlayerNum di S: pawn move ada di GetPawnMoves; wall dalam inventory, tidak overlap dan tidak menutup path siapa pun */
+    static bool IsActionLegal(const FMinimaxState& S, int32 PlayerNum, const FMinimaxAction& Act);
+
+    /** Gets only the pawn moves that step onto a shortest path to the goal row (used for a side with no walls left) */
+    static TArray<FIntPoint> GetShortestPathPawnMoves(const FMinimaxState& S, int32 PlayerNum);
+
+    /** Fills OutDist with the wall-aware step distance from every tile to PlayerNum's goal row (pawns ignored, 100 = unreachable) */
+    static void ComputeGoalDistances(const FMinimaxState& S, int32 PlayerNum, int32 OutDist[9][9]);
     
-    static TArray<FIntPoint> RecentMoves;
+    TArray<FIntPoint> RecentMoves;
+
+    /** When only the root player still has walls, RunSelectedAlgorithm switches to the deeper single-sided search */
+    bool bEnableSingleSidedSearch = true;
+
+    /** Upper bound for the single-sided search horizon (it keeps ceil(Depth/2) root plies and rounds Depth up to end on an opponent ply) */
+    static constexpr int32 MaxSingleSidedDepth = 12;
+
+    /** Adds (MyControl - OppControl) * BoardControlWeight from ComputeBoardControl to Evaluate */
+    bool bUseBoardControlTerm = false;
+    static constexpr int32 BoardControlWeight = 3;
+
+    /** Evaluate uses the learned network instead of the handcrafted terms once weights are loaded */
+    bool bUseLearnedEvaluator = false;
+
+    /** Read-only saat search, jadi satu set bobot boleh dibagi beberapa instance */
+    TSharedPtr<const FMinimaxNNUE> LearnedEvaluator;
+
+    /** Loads network weights (see FMinimaxNNUE for the file layout); call before starting a search */
+    bool LoadLearnedEvaluator(const FString& Path);
+    bool IsLearnedEvaluatorActive() const { return bUseLearnedEvaluator && LearnedEvaluator.IsValid() && LearnedEvaluator->IsLoaded(); }
 
+    /** Network untuk update Accumulator di search instance ini, nullptr jika learned evaluator tidak aktif */
+    const FMinimaxNNUE* GetActiveEvaluator() const { return IsLearnedEvaluatorActive() ? LearnedEvaluator.Get() : nullptr; }
+
+    /**
+     * Applies a pawn move to a state. Accumulator ikut di-update jika Network diberikan;
+     * tanpa Network, Accumulator yang valid ditandai tidak valid.
+     */
+    static void ApplyPawnMove(FMinimaxState& S, int32 PlayerNum, int32 X, int32 Y, const FMinimaxNNUE* Network = nullptr);
+
+    /** Applies a wall placement to a state (handles length & counts); Accumulator seperti ApplyPawnMove */
+    static void ApplyWall(FMinimaxState& S, int32 PlayerNum, const FWallData& W, const FMinimaxNNUE* Network = nullptr);
+
+    /** Batas thread ParallelFor di algoritma 2 / 4 (diisi scheduler per board); 0 = tanpa batas, 1 = serial */
+    int32 MaxSearchThreads = 0;
+
+    /**
+     * Mailbox yang menerima move terbaik sejauh ini, skor, depth dan node count selama search berjalan
+     * (diisi worker per job, nullptr = tidak publish). Node count dihitung sejak mailbox dipasang.
+     */
+    void SetProgressMailbox(FMinimaxSearchProgress* InProgress);
+
+    // --- Search caches & counters ---
+
+    FMinimaxSearchStats GetStats() const;
+    void ResetStats();
+
+    /** Mengosongkan transposition table, history table dan PV sebelumnya (mis. game baru) */
+    void ClearSearchCaches();
+
+    /**
+     * Cache search (TT, history, PV) hidup terus antar giliran game yang sama (lihat BeginTurn);
+     * GameId yang berbeda dari sebelumnya berarti game baru di board ini, jadi cache dikosongkan. 0 = tidak dicek.
+     */
+    void BeginGame(uint64 GameId);
+
+    /**
+     * Dipanggil sekali per giliran game (bukan per root: ponder, ponder miss dan iterative deepening mencari
+     * beberapa root untuk giliran yang sama). History di-age sekali, atau semua cache dikosongkan jika
+     * !bKeepCachesAcrossTurns. TurnIndex yang sama dengan sebelumnya diabaikan.
+     */
+    void BeginTurn(int32 TurnIndex);
+
+    /** true: TT move, history dan PV giliran lalu dipakai untuk ordering giliran berikutnya; false: mulai dingin tiap giliran */
+    bool bKeepCachesAcrossTurns = false;
+
+    FMinimaxTranspositionTable& GetTranspositionTable() { return TranspositionTable; }
 
 private: // These are primarily internal helpers - could be in .cpp as static
 
-    /** Applies a pawn move to a state */
-    static void ApplyPawnMove(FMinimaxState& S, int32 PlayerNum, int32 X, int32 Y);
+    static bool IsSearchStopped(const FMinimaxStopToken* Stop) { return Stop && Stop->IsStopRequested(); }
+
+    /** Root: satu root move selesai dicari (dibuang jika search di-stop di tengah) */
+    void ReportRootMove(const FMinimaxAction& Act, int32 Value, const FMinimaxStopToken* Stop);
+    /** Root: search satu depth selesai; hasil akhirnya dipublikasikan, PV-nya disimpan, lalu dikembalikan apa adanya */
+    FMinimaxResult FinishRootSearch(const FMinimaxState& Root, int32 PlayerTurn, const FMinimaxResult& Result, const FMinimaxStopToken* Stop);
+
+    /** ParallelFor yang memakai paling banyak MaxSearchThreads lane (index dibagi strided per lane) */
+    void ParallelForCapped(int32 Num, TFunctionRef<void(int32)> Body) const;
+
+    // --- Transposition table & move ordering (alpha-beta) ---
 
-    /** Applies a wall placement to a state (handles length & counts) */
-    static void ApplyWall(FMinimaxState& S, int32 PlayerNum, const FWallData& W);
+    /** Pawn move: Y * 9 + X; wall: 81 + ((Length - 1) * 2 + Horizontal) * 81 + Y * 9 + X */
+    static constexpr int32 HistorySize = 81 + 3 * 2 * 81;
+    static int32 HistoryIndex(const FMinimaxAction& Act);
+
+    /** True jika entry generasi ini cukup dalam untuk cutoff di window (alpha, beta); OutPackedAction diisi dari entry generasi mana pun */
+    bool ProbeTranspositionTable(uint64 Key, int32 Depth, int32 alpha, int32 beta, FMinimaxResult& OutResult, uint16& OutPackedAction);
+    void StoreTranspositionTable(uint64 Key, int32 Depth, int32 AlphaOrig, int32 BetaOrig, const FMinimaxResult& Result, const FMinimaxStopToken* Stop);
+
+    /** Action dari TT di depan, sisanya urut skor history (urutan generator dipertahankan jika skor sama) */
+    void OrderCandidates(TArray<FMinimaxAction>& Candidates, int32 PlayerNum, uint16 TTPackedAction) const;
+    /** Bonus history untuk move yang memotong (dibuang jika search di-stop: cutoff-nya dari nilai child yang tidak bermakna) */
+    void RecordCutoff(int32 PlayerNum, const FMinimaxAction& Act, int32 Depth, const FMinimaxStopToken* Stop);
+
+    /** Giliran baru (BeginTurn): skor history diperkecil (urutan dipertahankan, cutoff giliran ini lebih berbobot) */
+    void AgeHistory();
+
+    /** Ikuti move TT dari root untuk menyimpan principal variation (key node + move) */
+    void RememberPrincipalVariation(const FMinimaxState& Root, int32 PlayerTurn, const FMinimaxAction& RootAction);
+
+    /** Root baru: PV search sebelumnya ditulis ulang ke TT sebagai hint move generasi ini */
+    void SeedPreviousPrincipalVariation();
+
+    FMinimaxTranspositionTable TranspositionTable;
+    TAtomic<int32> History[2][HistorySize];
+
+    /** Root search terakhir; generasi TT naik saat root berganti karena Evaluate bergantung pada IdealPath root */
+    uint64 LastRootKey = 0;
+
+    /** Depth node Max di root search yang sedang berjalan (root tidak pernah diambil langsung dari TT) */
+    int32 CurrentRootDepth = 0;
+
+    /** Game yang memiliki isi cache sekarang (BeginGame) */
+    uint64 CurrentGameId = 0;
+
+    /** Giliran terakhir yang diterima BeginTurn; INDEX_NONE setelah cache dikosongkan */
+    int32 CurrentTurnIndex = INDEX_NONE;
+
+    /** PV search terakhir yang selesai: (key node, packed action), root di index 0 */
+    TArray<TPair<uint64, uint16>> PreviousPV;
+
+    TAtomic<int64> NodesSearched{ 0 };
+    TAtomic<int64> TTProbes{ 0 };
+    TAtomic<int64> TTHits{ 0 };
+    TAtomic<int64> TTCutoffs{ 0 };
+
+    FMinimaxSearchProgress* ProgressMailbox = nullptr;
+    int64 ProgressNodeBase = 0;
 
     /** The recursive Minimax algorithm */
-    static FMinimaxResult Max_Minimax(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 currturn, const TArray<FIntPoint>& IdealPath);
-    static FMinimaxResult Min_Minimax(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 currturn, const TArray<FIntPoint>& IdealPath);
+    FMinimaxResult Max_Minimax(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 currturn, const TArray<FIntPoint>& IdealPath, const FMinimaxStopToken* Stop = nullptr);
+    FMinimaxResult Min_Minimax(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 currturn, const TArray<FIntPoint>& IdealPath, const FMinimaxStopToken* Stop = nullptr);
 
-    static FMinimaxResult Max_ParallelMinimax(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 currturn, const TArray<FIntPoint>& IdealPath);
-    static FMinimaxResult Min_ParallelMinimax(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 currturn, const TArray<FIntPoint>& IdealPath);
+    FMinimaxResult Max_ParallelMinimax(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 currturn, const TArray<FIntPoint>& IdealPath, const FMinimaxStopToken* Stop = nullptr);
+    FMinimaxResult Min_ParallelMinimax(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 currturn, const TArray<FIntPoint>& IdealPath, const FMinimaxStopToken* Stop = nullptr);
     
-    static FMinimaxResult Max_MinimaxAlphaBeta(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 alpha, int32 beta, int32 currturn, const TArray<FIntPoint>
-                                               & IdealPath);
-    static FMinimaxResult Min_MinimaxAlphaBeta(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 alpha, int32 beta, int32 currturn, const TArray<FIntPoint>
-                                               & IdealPath);
+    FMinimaxResult Max_MinimaxAlphaBeta(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 alpha, int32 beta, int32 currturn, const TArray<FIntPoint>& IdealPath, const FMinimaxStopToken* Stop = nullptr);
+    FMinimaxResult Min_MinimaxAlphaBeta(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 alpha, int32 beta, int32 currturn, const TArray<FIntPoint>& IdealPath, const FMinimaxStopToken* Stop = nullptr);
     
-    static FMinimaxResult Max_ParallelMinimaxAlphaBeta(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 alpha, int32 beta, int32 currturn, const TArray<FIntPoint>
-                                                       & IdealPath);
-    static FMinimaxResult Min_ParallelMinimaxAlphaBeta(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 alpha, int32 beta, int32 currturn, const TArray<FIntPoint>
-                                                       & IdealPath);
-    static FMinimaxResult SolveMinimax(const FMinimaxState& Initial, int32 Depth, int32 RootPlayer);
+    FMinimaxResult Max_ParallelMinimaxAlphaBeta(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 alpha, int32 beta, int32 currturn, const TArray<FIntPoint>& IdealPath, const FMinimaxStopToken* Stop = nullptr);
+    FMinimaxResult Min_ParallelMinimaxAlphaBeta(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 alpha, int32 beta, int32 currturn, const TArray<FIntPoint>& IdealPath, const FMinimaxStopToken* Stop = nullptr);
+    FMinimaxResult SolveMinimax(const FMinimaxState& Initial, int32 Depth, int32 RootPlayer);
+
+    /** Alpha-Beta for the asymmetric endgame: a side without walls only walks its shortest-path successors */
+    FMinimaxResult Max_SingleSidedAlphaBeta(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 alpha, int32 beta, int32 currturn, const TArray<FIntPoint>& IdealPath, const FMinimaxStopToken* Stop = nullptr);
+    FMinimaxResult Min_SingleSidedAlphaBeta(const FMinimaxState& S, int32 Depth, int32 RootPlayer, int32 alpha, int32 beta, int32 currturn, const TArray<FIntPoint>& IdealPath, const FMinimaxStopToken* Stop = nullptr);
+    static void GatherSingleSidedCandidates(const FMinimaxState& S, int32 PlayerNum, TArray<FMinimaxAction>& OutCandidates);
 
     /** The recursive Minimax algorithm with Alpha-Beta Pruning */
-    static int32 MinimaxAlphaBeta(FMinimaxState S, int32 Depth, int32 RootPlayer, int32 CurrentPlayer, int32 Alpha, int32 Beta);
+    int32 MinimaxAlphaBeta(FMinimaxState S, int32 Depth, int32 RootPlayer, int32 CurrentPlayer, int32 Alpha, int32 Beta);
 
     /** Checks if a wall placement is strictly legal (bounds, overlaps, basic intersections) */
     static bool IsWallPlacementStrictlyLegal(const FMinimaxState& S, const FWallData& W);
@@ -169,7 +380,7 @@ private: // These are primarily internal helpers - could be in .cpp as static
     static bool DoesWallBlockPlayer(FMinimaxState& TempState);
     static void PrintBlockedWalls(const FMinimaxState& S, const FString& Context);
 
-    /** Helper to estimate board control/mobility using BFS */
+    /** Counts tiles each pawn reaches strictly first (bitboard Voronoi, walls respected, ties neutral) */
     static void ComputeBoardControl(const FMinimaxState& S, int32& MyControl, int32& OppControl, int32 RootPlayer);
     static void PrintInventory(const FMinimaxState& S, const FString& Context);
 
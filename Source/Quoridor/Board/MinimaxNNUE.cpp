@@ -0,0 +1,208 @@
+﻿// MinimaxNNUE.cpp
+#include "MinimaxNNUE.h"
+#include "MinimaxEngine.h"
+#include "Misc/FileHelper.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+#include <immintrin.h>
+#endif
+
+//-----------------------------------------------------------------------------
+// Load weights
+//-----------------------------------------------------------------------------
+bool FMinimaxNNUE::LoadFromFile(const FString& Path)
+{
+    bLoaded = false;
+
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *Path))
+    {
+        UE_LOG(LogTemp, Error, TEXT("FMinimaxNNUE: Tidak bisa membaca file weights %s"), *Path);
+        return false;
+    }
+
+    int64 Offset = 0;
+    auto Read = [&](void* Dest, int64 Size) -> bool
+    {
+        if (Offset + Size > Bytes.Num())
+            return false;
+        FMemory::Memcpy(Dest, Bytes.GetData() + Offset, Size);
+        Offset += Size;
+        return true;
+    };
+
+    char Magic[4];
+    uint32 Version = 0, Features = 0, Hidden = 0;
+    if (!Read(Magic, 4) || FMemory::Memcmp(Magic, "QNNU", 4) != 0 ||
+        !Read(&Version, sizeof(Version)) || Version != 1 ||
+        !Read(&Features, sizeof(Features)) || Features != FeatureCount ||
+        !Read(&Hidden, sizeof(Hidden)) || Hidden != HiddenSize)
+    {
+        UE_LOG(LogTemp, Error, TEXT("FMinimaxNNUE: Header %s tidak cocok (version=%u features=%u hidden=%u)"),
+            *Path, Version, Features, Hidden);
+        return false;
+    }
+
+    FeatureWeights.SetNumUninitialized(FeatureCount * HiddenSize);
+    if (!Read(FeatureWeights.GetData(), sizeof(int16) * FeatureCount * HiddenSize) ||
+        !Read(HiddenBias, sizeof(HiddenBias)) ||
+        !Read(OutputWeights, sizeof(OutputWeights)) ||
+        !Read(&OutputBias, sizeof(OutputBias)) ||
+        !Read(&OutputDivisor, sizeof(OutputDivisor)) ||
+        OutputDivisor == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("FMinimaxNNUE: File weights %s terpotong atau rusak"), *Path);
+        FeatureWeights.Empty();
+        return false;
+    }
+
+    bLoaded = true;
+    UE_LOG(LogTemp, Log, TEXT("FMinimaxNNUE: Loaded %s (%d features x %d hidden)"), *Path, FeatureCount, HiddenSize);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Accumulator updates (int16, 16 lanes per AVX2 register / 8 per SSE2)
+//-----------------------------------------------------------------------------
+void FMinimaxNNUE::AddFeature(FMinimaxAccumulator& Acc, int32 Feature) const
+{
+    const int16* Column = FeatureWeights.GetData() + Feature * HiddenSize;
+
+#if PLATFORM_CPU_X86_FAMILY && defined(__AVX2__)
+    for (int32 i = 0; i < HiddenSize; i += 16)
+    {
+        __m256i A = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Acc.Values + i));
+        __m256i W = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Column + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(Acc.Values + i), _mm256_add_epi16(A, W));
+    }
+#elif PLATFORM_CPU_X86_FAMILY
+    for (int32 i = 0; i < HiddenSize; i += 8)
+    {
+        __m128i A = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Acc.Values + i));
+        __m128i W = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Column + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Acc.Values + i), _mm_add_epi16(A, W));
+    }
+#else
+    for (int32 i = 0; i < HiddenSize; ++i)
+        Acc.Values[i] += Column[i];
+#endif
+}
+
+void FMinimaxNNUE::RemoveFeature(FMinimaxAccumulator& Acc, int32 Feature) const
+{
+    const int16* Column = FeatureWeights.GetData() + Feature * HiddenSize;
+
+#if PLATFORM_CPU_X86_FAMILY && defined(__AVX2__)
+    for (int32 i = 0; i < HiddenSize; i += 16)
+    {
+        __m256i A = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Acc.Values + i));
+        __m256i W = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Column + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(Acc.Values + i), _mm256_sub_epi16(A, W));
+    }
+#elif PLATFORM_CPU_X86_FAMILY
+    for (int32 i = 0; i < HiddenSize; i += 8)
+    {
+        __m128i A = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Acc.Values + i));
+        __m128i W = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Column + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Acc.Values + i), _mm_sub_epi16(A, W));
+    }
+#else
+    for (int32 i = 0; i < HiddenSize; ++i)
+        Acc.Values[i] -= Column[i];
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Full refresh
+//-----------------------------------------------------------------------------
+void FMinimaxNNUE::RefreshAccumulator(FMinimaxState& S) const
+{
+    FMinimaxAccumulator& Acc = S.Accumulator;
+    Acc.bValid = false;
+    if (!bLoaded)
+        return;
+
+    FMemory::Memcpy(Acc.Values, HiddenBias, sizeof(HiddenBias));
+
+    for (int32 p = 0; p < 2; ++p)
+    {
+        if (S.PawnX[p] >= 0 && S.PawnX[p] <= 8 && S.PawnY[p] >= 0 && S.PawnY[p] <= 8)
+            AddFeature(Acc, PawnFeature(p, S.PawnX[p], S.PawnY[p]));
+
+        for (int32 Length = 1; Length <= 3; ++Length)
+            AddFeature(Acc, InventoryFeature(p, Length, S.WallCounts[p][Length - 1]));
+    }
+
+    for (int32 y = 0; y < 8; ++y)
+        for (int32 x = 0; x < 9; ++x)
+            if (S.HorizontalBlocked[y][x])
+                AddFeature(Acc, HorizontalFeature(x, y));
+
+    for (int32 y = 0; y < 9; ++y)
+        for (int32 x = 0; x < 8; ++x)
+            if (S.VerticalBlocked[y][x])
+                AddFeature(Acc, VerticalFeature(x, y));
+
+    Acc.bValid = true;
+}
+
+//-----------------------------------------------------------------------------
+// Output layer: ClippedReLU + int16 dot product (madd -> int32 lanes)
+//-----------------------------------------------------------------------------
+int32 FMinimaxNNUE::Forward(const FMinimaxAccumulator& Acc) const
+{
+    int32 Sum = 0;
+
+#if PLATFORM_CPU_X86_FAMILY && defined(__AVX2__)
+    const __m256i Zero = _mm256_setzero_si256();
+    const __m256i Clip = _mm256_set1_epi16(ClipMax);
+    __m256i Total = _mm256_setzero_si256();
+    for (int32 i = 0; i < HiddenSize; i += 16)
+    {
+        __m256i A = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Acc.Values + i));
+        __m256i W = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(OutputWeights + i));
+        A = _mm256_min_epi16(_mm256_max_epi16(A, Zero), Clip);
+        Total = _mm256_add_epi32(Total, _mm256_madd_epi16(A, W));
+    }
+    __m128i Half = _mm_add_epi32(_mm256_castsi256_si128(Total), _mm256_extracti128_si256(Total, 1));
+    Half = _mm_add_epi32(Half, _mm_shuffle_epi32(Half, _MM_SHUFFLE(1, 0, 3, 2)));
+    Half = _mm_add_epi32(Half, _mm_shuffle_epi32(Half, _MM_SHUFFLE(2, 3, 0, 1)));
+    Sum = _mm_cvtsi128_si32(Half);
+#elif PLATFORM_CPU_X86_FAMILY
+    const __m128i Zero = _mm_setzero_si128();
+    const __m128i Clip = _mm_set1_epi16(ClipMax);
+    __m128i Total = _mm_setzero_si128();
+    for (int32 i = 0; i < HiddenSize; i += 8)
+    {
+        __m128i A = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Acc.Values + i));
+        __m128i W = _mm_loadu_si128(reinterpret_cast<const __m128i*>(OutputWeights + i));
+        A = _mm_min_epi16(_mm_max_epi16(A, Zero), Clip);
+        Total = _mm_add_epi32(Total, _mm_madd_epi16(A, W));
+    }
+    Total = _mm_add_epi32(Total, _mm_shuffle_epi32(Total, _MM_SHUFFLE(1, 0, 3, 2)));
+    Total = _mm_add_epi32(Total, _mm_shuffle_epi32(Total, _MM_SHUFFLE(2, 3, 0, 1)));
+    Sum = _mm_cvtsi128_si32(Total);
+#else
+    for (int32 i = 0; i < HiddenSize; ++i)
+        Sum += FMath::Clamp<int32>(Acc.Values[i], 0, ClipMax) * OutputWeights[i];
+#endif
+
+    return (Sum + OutputBias) / OutputDivisor;
+}
+
+int32 FMinimaxNNUE::Evaluate(const FMinimaxState& S, int32 RootPlayer) const
+{
+    int32 Score;
+    if (S.Accumulator.bValid)
+    {
+        Score = Forward(S.Accumulator);
+    }
+    else
+    {
+        FMinimaxState Fresh = S;
+        RefreshAccumulator(Fresh);
+        Score = Forward(Fresh.Accumulator);
+    }
+
+    return (RootPlayer == 1) ? Score : -Score;
+}
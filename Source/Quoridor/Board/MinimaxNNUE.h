@@ -0,0 +1,83 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMinimaxState;
+
+//-----------------------------------------------------------------------------
+// FMinimaxAccumulator - First layer of the learned evaluator, carried inside
+// FMinimaxState and updated incrementally by ApplyPawnMove / ApplyWall
+//-----------------------------------------------------------------------------
+struct FMinimaxAccumulator
+{
+    static constexpr int32 HiddenSize = 32;
+
+    int16 Values[HiddenSize];
+
+    // False until FMinimaxNNUE::RefreshAccumulator has filled Values for this state
+    bool bValid = false;
+};
+
+//-----------------------------------------------------------------------------
+// FMinimaxNNUE - Small NNUE-style evaluator over sparse board features
+//
+// Features (all binary, absolute board orientation):
+//   [  0..161]  pawn square, Player * 81 + Y * 9 + X
+//   [162..233]  HorizontalBlocked[Y][X]
+//   [234..305]  VerticalBlocked[Y][X]
+//   [306..371]  inventory one-hot, (Player * 3 + (Length - 1)) * 11 + Count
+//
+// Score = (ClippedReLU(Accumulator) . OutputWeights + OutputBias) / OutputDivisor,
+// from Player 1's point of view.
+//
+// Weight file layout (little endian); the file is produced outside the project:
+//   char[4] "QNNU", uint32 Version (1), uint32 FeatureCount, uint32 HiddenSize,
+//   int16 FeatureWeights[FeatureCount][HiddenSize], int16 HiddenBias[HiddenSize],
+//   int16 OutputWeights[HiddenSize], int32 OutputBias, int32 OutputDivisor
+//-----------------------------------------------------------------------------
+class FMinimaxNNUE
+{
+public:
+    static constexpr int32 HiddenSize        = FMinimaxAccumulator::HiddenSize;
+    static constexpr int32 MaxInventoryCount = 10;
+
+    static constexpr int32 PawnFeatureBase       = 0;
+    static constexpr int32 HorizontalFeatureBase = PawnFeatureBase + 2 * 81;
+    static constexpr int32 VerticalFeatureBase   = HorizontalFeatureBase + 8 * 9;
+    static constexpr int32 InventoryFeatureBase  = VerticalFeatureBase + 9 * 8;
+    static constexpr int32 FeatureCount          = InventoryFeatureBase + 2 * 3 * (MaxInventoryCount + 1);
+
+    static constexpr int32 ClipMax = 127;
+
+    static int32 PawnFeature(int32 PlayerIdx, int32 X, int32 Y) { return PawnFeatureBase + PlayerIdx * 81 + Y * 9 + X; }
+    static int32 HorizontalFeature(int32 X, int32 Y) { return HorizontalFeatureBase + Y * 9 + X; }
+    static int32 VerticalFeature(int32 X, int32 Y) { return VerticalFeatureBase + Y * 8 + X; }
+    static int32 InventoryFeature(int32 PlayerIdx, int32 Length, int32 Count)
+    {
+        return InventoryFeatureBase + (PlayerIdx * 3 + (Length - 1)) * (MaxInventoryCount + 1) + FMath::Clamp(Count, 0, MaxInventoryCount);
+    }
+
+    /** Loads a weight file in the layout above; returns false (and keeps nothing) on any format mismatch */
+    bool LoadFromFile(const FString& Path);
+    bool IsLoaded() const { return bLoaded; }
+
+    /** Rebuilds the accumulator from scratch (root of a search, or after FromBoard) */
+    void RefreshAccumulator(FMinimaxState& S) const;
+
+    /** Incremental first-layer updates */
+    void AddFeature(FMinimaxAccumulator& Acc, int32 Feature) const;
+    void RemoveFeature(FMinimaxAccumulator& Acc, int32 Feature) const;
+
+    /** Output layer; refreshes a copy of the accumulator first if S was never initialised */
+    int32 Evaluate(const FMinimaxState& S, int32 RootPlayer) const;
+
+private:
+    int32 Forward(const FMinimaxAccumulator& Acc) const;
+
+    TArray<int16> FeatureWeights; // [FeatureCount * HiddenSize]
+    int16 HiddenBias[HiddenSize] = {};
+    int16 OutputWeights[HiddenSize] = {};
+    int32 OutputBias = 0;
+    int32 OutputDivisor = 64;
+    bool  bLoaded = false;
+};
@@ -0,0 +1,97 @@
+﻿// MinimaxSearchProgress.cpp
+#include "MinimaxSearchProgress.h"
+#include "MinimaxEngine.h"
+#include "MinimaxTranspositionTable.h"
+#include "HAL/PlatformProcess.h"
+
+FMinimaxAction FMinimaxSearchSnapshot::GetBestAction() const
+{
+    return FMinimaxTranspositionTable::DecodeAction(PackedBestAction);
+}
+
+FMinimaxSearchProgress::FMinimaxSearchProgress()
+    : StartSeconds(FPlatformTime::Seconds())
+{
+}
+
+void FMinimaxSearchProgress::OfferRootMove(const FMinimaxAction& Act, int32 Score, int32 Depth, int64 Nodes)
+{
+    FScopeLock Lock(&WriterLock);
+
+    // Depth baru (iterative deepening): move depth sebelumnya tetap dipublikasikan sampai ada root move yang selesai
+    if (Depth != WriterDepth)
+    {
+        WriterDepth = Depth;
+        WriterDepthBest = INT_MIN;
+    }
+
+    const uint16 Packed = FMinimaxTranspositionTable::EncodeAction(Act);
+    if (Packed != 0 && Score > WriterDepthBest)
+    {
+        WriterDepthBest = Score;
+        WriterPackedAction = Packed;
+        WriterScore = Score;
+    }
+
+    // Node count tetap ikut di-update walaupun move terbaik tidak berubah
+    Publish(WriterPackedAction, WriterScore, Depth, WriterCompletedDepth, Nodes);
+}
+
+void FMinimaxSearchProgress::CompleteDepth(const FMinimaxAction& Act, int32 Score, int32 Depth, int64 Nodes)
+{
+    FScopeLock Lock(&WriterLock);
+
+    const uint16 Packed = FMinimaxTranspositionTable::EncodeAction(Act);
+    if (Packed != 0)
+    {
+        WriterPackedAction = Packed;
+        WriterScore = Score;
+    }
+    WriterDepth = Depth;
+    WriterDepthBest = Score;
+    WriterCompletedDepth = FMath::Max(WriterCompletedDepth, Depth);
+
+    Publish(WriterPackedAction, WriterScore, Depth, WriterCompletedDepth, Nodes);
+}
+
+void FMinimaxSearchProgress::Publish(uint16 PackedAction, int32 Score, int32 Depth, int32 InCompletedDepth, int64 Nodes)
+{
+    const int64 Micros = static_cast<int64>((FPlatformTime::Seconds() - StartSeconds) * 1e6);
+
+    // Semua akses atomic sequentially consistent, jadi pembaca yang melihat Sequence genap
+    // yang sama sebelum dan sesudah membaca field pasti mendapat satu publish utuh
+    Sequence.Store(Sequence.Load() + 1); // ganjil: sedang menulis
+    PackedBestAction.Store(PackedAction);
+    BestScore.Store(Score);
+    SearchDepth.Store(Depth);
+    CompletedDepth.Store(InCompletedDepth);
+    NodesSearched.Store(Nodes);
+    ElapsedMicroseconds.Store(Micros);
+    Sequence.Store(Sequence.Load() + 1);
+}
+
+bool FMinimaxSearchProgress::Read(FMinimaxSearchSnapshot& Out) const
+{
+    for (;;)
+    {
+        const uint32 Before = Sequence.Load();
+        if (Before & 1)
+        {
+            FPlatformProcess::Yield();
+            continue;
+        }
+
+        Out.PackedBestAction = static_cast<uint16>(PackedBestAction.Load());
+        Out.Score = BestScore.Load();
+        Out.Depth = SearchDepth.Load();
+        Out.CompletedDepth = CompletedDepth.Load();
+        Out.NodesSearched = NodesSearched.Load();
+        Out.ElapsedSeconds = ElapsedMicroseconds.Load() / 1e6;
+
+        if (Sequence.Load() == Before)
+        {
+            Out.Sequence = Before >> 1;
+            return Out.HasMove();
+        }
+    }
+}
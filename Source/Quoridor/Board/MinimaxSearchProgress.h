@@ -0,0 +1,78 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMinimaxAction;
+
+/** Salinan konsisten isi FMinimaxSearchProgress pada satu saat */
+struct FMinimaxSearchSnapshot
+{
+    uint16 PackedBestAction = 0; // FMinimaxTranspositionTable::EncodeAction; 0 = belum ada move
+    int32 Score = 0;
+    int32 Depth = 0;             // Depth root yang sedang / terakhir dicari
+    int32 CompletedDepth = 0;    // Depth terakhir yang selesai penuh (0 = Score / move masih parsial)
+    int64 NodesSearched = 0;
+    double ElapsedSeconds = 0.0;
+    uint32 Sequence = 0;         // Naik setiap publish; sama = tidak ada yang berubah
+
+    bool HasMove() const { return (PackedBestAction & 1) != 0; }
+    FMinimaxAction GetBestAction() const;
+    double GetNodesPerSecond() const { return ElapsedSeconds > 0.0 ? NodesSearched / ElapsedSeconds : 0.0; }
+};
+
+//-----------------------------------------------------------------------------
+// FMinimaxSearchProgress - Lock-free mailbox for one running search
+//
+// Search (thread pool, bisa beberapa thread ParallelFor sekaligus) menulis
+// setiap kali satu root move selesai dicari: move terbaik sejauh ini di depth
+// ini, skornya, depth dan jumlah node. Penulis diserialisasi lewat lock kecil
+// yang hanya disentuh search; pembaca (game thread, UI) tidak pernah memegang
+// lock dan tidak pernah menahan search: seqlock, Read diulang jika bertabrakan
+// dengan publish.
+//
+// Move yang dipublikasikan selalu legal dan sudah dicari penuh sampai Depth,
+// jadi caller boleh menghentikan search kapan saja dan memainkannya.
+//-----------------------------------------------------------------------------
+class QUORIDOR_API FMinimaxSearchProgress
+{
+public:
+    FMinimaxSearchProgress();
+    UE_NONCOPYABLE(FMinimaxSearchProgress);
+
+    // --- Penulis (search) ---
+
+    /** Satu root move selesai dengan nilai Score; dipublikasikan jika lebih baik dari move terbaik di depth ini */
+    void OfferRootMove(const FMinimaxAction& Act, int32 Score, int32 Depth, int64 Nodes);
+
+    /** Depth selesai penuh; Act adalah hasil akhir search (setelah tie-break IdealPath) */
+    void CompleteDepth(const FMinimaxAction& Act, int32 Score, int32 Depth, int64 Nodes);
+
+    // --- Pembaca (thread mana saja) ---
+
+    /** Snapshot konsisten; false jika search belum mempublikasikan move */
+    bool Read(FMinimaxSearchSnapshot& Out) const;
+
+    /** Murah untuk polling tiap tick: berubah setiap ada publish */
+    uint32 GetSequence() const { return Sequence.Load() >> 1; }
+
+private:
+    void Publish(uint16 PackedAction, int32 Score, int32 Depth, int32 InCompletedDepth, int64 Nodes);
+
+    // Seqlock: ganjil selama publish berjalan
+    TAtomic<uint32> Sequence{ 0 };
+    TAtomic<uint32> PackedBestAction{ 0 };
+    TAtomic<int32> BestScore{ 0 };
+    TAtomic<int32> SearchDepth{ 0 };
+    TAtomic<int32> CompletedDepth{ 0 };
+    TAtomic<int64> NodesSearched{ 0 };
+    TAtomic<int64> ElapsedMicroseconds{ 0 };
+
+    // Hanya dipakai penulis, di bawah WriterLock
+    FCriticalSection WriterLock;
+    double StartSeconds = 0.0;
+    int32 WriterDepth = 0;
+    int32 WriterDepthBest = INT_MIN;
+    uint16 WriterPackedAction = 0;
+    int32 WriterScore = 0;
+    int32 WriterCompletedDepth = 0;
+};
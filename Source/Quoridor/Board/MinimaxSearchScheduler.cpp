@@ -0,0 +1,200 @@
+﻿// MinimaxSearchScheduler.cpp
+#include "MinimaxSearchScheduler.h"
+#include "MinimaxSearchWorker.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformMisc.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+namespace
+{
+    FCriticalSection GSharedSchedulerLock;
+    TWeakPtr<FMinimaxSearchScheduler> GSharedScheduler;
+}
+
+TSharedRef<FMinimaxSearchScheduler> FMinimaxSearchScheduler::Acquire()
+{
+    FScopeLock ScopeLock(&GSharedSchedulerLock);
+
+    if (TSharedPtr<FMinimaxSearchScheduler> Existing = GSharedScheduler.Pin())
+    {
+        return Existing.ToSharedRef();
+    }
+
+    // Sisakan satu core untuk game thread
+    int32 NumThreads = FMath::Max(1, FPlatformMisc::NumberOfCores() - 1);
+    FParse::Value(FCommandLine::Get(), TEXT("MinimaxSearchThreads="), NumThreads);
+
+    TSharedRef<FMinimaxSearchScheduler> Scheduler = MakeShared<FMinimaxSearchScheduler>(FMath::Max(1, NumThreads));
+    GSharedScheduler = Scheduler;
+    return Scheduler;
+}
+
+FMinimaxSearchScheduler::FMinimaxSearchScheduler(int32 InNumThreads)
+{
+    NumCores = FMath::Max(1, FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+    for (int32 i = 0; i < InNumThreads; ++i)
+    {
+        Threads.Add(MakeUnique<FPoolThread>(*this, i));
+    }
+    UE_LOG(LogTemp, Log, TEXT("FMinimaxSearchScheduler: %d search thread"), InNumThreads);
+}
+
+FMinimaxSearchScheduler::~FMinimaxSearchScheduler()
+{
+    // Semua worker sudah melepas scheduler, jadi tidak ada job yang masih jalan
+    Threads.Empty();
+}
+
+void FMinimaxSearchScheduler::NotifyWork(const TSharedRef<FMinimaxSearchWorker>& Client)
+{
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (RunningClients.Contains(&Client.Get()))
+            return; // Thread yang sedang menjalankannya akan menjadwalkan ulang
+
+        for (const TWeakPtr<FMinimaxSearchWorker>& Ready : ReadyClients)
+        {
+            if (Ready.HasSameObject(&Client.Get()))
+                return;
+        }
+        ReadyClients.Add(Client);
+    }
+    WakeAll();
+}
+
+void FMinimaxSearchScheduler::RemoveClient(FMinimaxSearchWorker* Client)
+{
+    for (;;)
+    {
+        {
+            FScopeLock ScopeLock(&Lock);
+            ReadyClients.RemoveAll([Client](const TWeakPtr<FMinimaxSearchWorker>& Ready)
+            {
+                return !Ready.IsValid() || Ready.HasSameObject(Client);
+            });
+            if (!RunningClients.Contains(Client))
+                return;
+        }
+
+        // Job client ini sudah di-cancel caller, jadi keluar dalam orde satu node search
+        FPlatformProcess::Sleep(0.001f);
+    }
+}
+
+bool FMinimaxSearchScheduler::RunOne()
+{
+    TSharedPtr<FMinimaxSearchWorker> Client;
+    int32 SearchThreads = 1;
+    {
+        FScopeLock ScopeLock(&Lock);
+        while (!Client.IsValid() && ReadyClients.Num() > 0)
+        {
+            Client = ReadyClients[0].Pin();
+            ReadyClients.RemoveAt(0, 1, EAllowShrinking::No);
+        }
+        if (!Client.IsValid())
+            return false;
+
+        RunningClients.Add(Client.Get());
+
+        // Bagian adil core untuk ParallelFor search ini, kecuali board memberi cap sendiri
+        const int32 Cap = Client->GetSearchThreadCap();
+        SearchThreads = Cap > 0 ? Cap : FMath::Max(1, NumCores / RunningClients.Num());
+    }
+
+    Client->RunNextJob(SearchThreads);
+    FMinimaxSearchWorker* RawClient = Client.Get();
+    const TWeakPtr<FMinimaxSearchWorker> WeakClient = Client;
+
+    // Referensi kuat dilepas sebelum keluar dari RunningClients: setelah RemoveClient kembali,
+    // worker (dan scheduler) selalu dihancurkan oleh pemiliknya, tidak pernah di thread pool
+    Client.Reset();
+
+    bool bRequeued = false;
+    {
+        FScopeLock ScopeLock(&Lock);
+        RunningClients.RemoveSingleSwap(RawClient, EAllowShrinking::No);
+
+        // Dicek di bawah Lock: Enqueue yang masuk selama job jalan dilewati NotifyWork (client masih Running).
+        // Kembali ke belakang antrean supaya board lain dapat giliran lebih dulu.
+        if (RawClient->HasQueuedJobs())
+        {
+            ReadyClients.Add(WeakClient);
+            bRequeued = true;
+        }
+    }
+
+    if (bRequeued)
+        WakeAll();
+    return true;
+}
+
+void FMinimaxSearchScheduler::WakeAll()
+{
+    for (const TUniquePtr<FPoolThread>& PoolThread : Threads)
+    {
+        PoolThread->Wake();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// FPoolThread
+//-----------------------------------------------------------------------------
+FMinimaxSearchScheduler::FPoolThread::FPoolThread(FMinimaxSearchScheduler& InOwner, int32 Index)
+    : Owner(InOwner)
+{
+    WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    Thread = FRunnableThread::Create(this, *FString::Printf(TEXT("MinimaxSearchPool_%d"), Index), 0, TPri_Normal);
+
+    if (!Thread)
+    {
+        UE_LOG(LogTemp, Error, TEXT("FMinimaxSearchScheduler: Gagal membuat thread pool %d"), Index);
+    }
+}
+
+FMinimaxSearchScheduler::FPoolThread::~FPoolThread()
+{
+    if (Thread)
+    {
+        Thread->Kill(true);
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    if (WakeEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+        WakeEvent = nullptr;
+    }
+}
+
+void FMinimaxSearchScheduler::FPoolThread::Wake()
+{
+    if (WakeEvent)
+    {
+        WakeEvent->Trigger();
+    }
+}
+
+uint32 FMinimaxSearchScheduler::FPoolThread::Run()
+{
+    while (!bStopping.Load())
+    {
+        // Event auto-reset di-trigger setiap ada kerja baru, jadi kerja yang masuk
+        // antara RunOne yang kosong dan Wait tidak hilang
+        if (!Owner.RunOne())
+        {
+            WakeEvent->Wait();
+        }
+    }
+    return 0;
+}
+
+void FMinimaxSearchScheduler::FPoolThread::Stop()
+{
+    bStopping = true;
+    Wake();
+}
@@ -0,0 +1,72 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+
+class FMinimaxSearchWorker;
+class FRunnableThread;
+class FEvent;
+
+//-----------------------------------------------------------------------------
+// FMinimaxSearchScheduler - Bounded thread pool shared by every board's
+// FMinimaxSearchWorker queue
+//
+// Jumlah thread tetap (default core fisik - 1, override -MinimaxSearchThreads=N)
+// berapapun jumlah board. Board yang punya job antre masuk antrean Ready
+// round-robin: satu thread mengambil SATU job dari board terdepan, lalu board
+// itu kembali ke belakang antrean jika masih punya job. Satu board tidak pernah
+// dilayani dua thread sekaligus (engine per pemain hanya boleh satu search).
+//
+// Thread ParallelFor di dalam satu search dibatasi per board: cap board itu,
+// atau jika 0, bagian adil core dibagi board yang sedang mencari.
+//
+// Dimiliki bersama oleh worker lewat Acquire; thread dimatikan saat worker
+// terakhir dilepas, jadi tidak perlu hook shutdown module.
+//-----------------------------------------------------------------------------
+class QUORIDOR_API FMinimaxSearchScheduler
+{
+public:
+    /** Pool bersama; dibuat jika belum ada */
+    static TSharedRef<FMinimaxSearchScheduler> Acquire();
+
+    explicit FMinimaxSearchScheduler(int32 InNumThreads);
+    ~FMinimaxSearchScheduler();
+
+    int32 GetNumThreads() const { return Threads.Num(); }
+
+    /** Game thread: Client punya job baru; dijadwalkan jika belum antre / sedang jalan */
+    void NotifyWork(const TSharedRef<FMinimaxSearchWorker>& Client);
+
+    /** Mengeluarkan Client dari antrean dan menunggu job-nya yang sedang jalan selesai */
+    void RemoveClient(FMinimaxSearchWorker* Client);
+
+private:
+    class FPoolThread : public FRunnable
+    {
+    public:
+        FPoolThread(FMinimaxSearchScheduler& InOwner, int32 Index);
+        virtual ~FPoolThread() override;
+
+        void Wake();
+
+        // FRunnable
+        virtual uint32 Run() override;
+        virtual void Stop() override;
+
+    private:
+        FMinimaxSearchScheduler& Owner;
+        FEvent* WakeEvent = nullptr;
+        FRunnableThread* Thread = nullptr;
+        TAtomic<bool> bStopping{ false };
+    };
+
+    /** Pool thread: ambil board berikutnya dan jalankan satu job-nya; false jika tidak ada kerja */
+    bool RunOne();
+    void WakeAll();
+
+    FCriticalSection Lock;
+    TArray<TWeakPtr<FMinimaxSearchWorker>> ReadyClients; // round-robin, tiap board paling banyak sekali
+    TArray<FMinimaxSearchWorker*> RunningClients;
+    TArray<TUniquePtr<FPoolThread>> Threads;
+    int32 NumCores = 1;
+};
@@ -0,0 +1,137 @@
+﻿// MinimaxSearchWorker.cpp
+#include "MinimaxSearchWorker.h"
+#include "MinimaxSearchScheduler.h"
+#include "Async/Async.h"
+
+FMinimaxSearchWorker::FMinimaxSearchWorker(const FString& InName)
+    : Name(InName)
+    , Scheduler(FMinimaxSearchScheduler::Acquire())
+{
+}
+
+FMinimaxSearchWorker::~FMinimaxSearchWorker()
+{
+    // Shutdown menunggu job yang sedang jalan; di sini hanya membuang sisa antrean
+    bStopping = true;
+    FMinimaxSearchJob Dropped;
+    while (Jobs.Dequeue(Dropped))
+    {
+        --PendingJobs;
+    }
+}
+
+TSharedPtr<FMinimaxStopToken> FMinimaxSearchWorker::Enqueue(FMinimaxSearchJob&& Job)
+{
+    if (!Job.StopToken.IsValid())
+    {
+        Job.StopToken = MakeShared<FMinimaxStopToken>();
+    }
+    TSharedPtr<FMinimaxStopToken> Token = Job.StopToken;
+
+    if (!Scheduler.IsValid() || bStopping.Load())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("FMinimaxSearchWorker: Job %s ditolak, worker tidak aktif"), *Name);
+        Token->RequestStop();
+        return Token;
+    }
+
+    Job.Generation = CancelGeneration.Load();
+    ++PendingJobs;
+    Jobs.Enqueue(MoveTemp(Job));
+    Scheduler->NotifyWork(AsShared());
+    return Token;
+}
+
+void FMinimaxSearchWorker::CancelAll()
+{
+    // Job yang masih antre jadi generasi lama; RunNextJob membuangnya tanpa mencari
+    ++CancelGeneration;
+
+    FScopeLock Lock(&CurrentJobLock);
+    if (CurrentStopToken.IsValid())
+    {
+        CurrentStopToken->RequestStop();
+    }
+}
+
+void FMinimaxSearchWorker::Shutdown()
+{
+    if (!Scheduler.IsValid())
+        return;
+
+    // Search yang sedang jalan keluar di node berikutnya, jadi RemoveClient tidak menunggu lama
+    bStopping = true;
+    CancelAll();
+    Scheduler->RemoveClient(this);
+    Scheduler.Reset();
+
+    FMinimaxSearchJob Dropped;
+    while (Jobs.Dequeue(Dropped))
+    {
+        --PendingJobs;
+    }
+}
+
+void FMinimaxSearchWorker::RunNextJob(int32 SearchThreads)
+{
+    FMinimaxSearchJob Job;
+    if (bStopping.Load() || !Jobs.Dequeue(Job))
+        return;
+
+    {
+        FScopeLock Lock(&CurrentJobLock);
+        if (Job.Generation != CancelGeneration.Load() || Job.StopToken->IsCancelled())
+        {
+            // Dibatalkan (CancelAll atau token job ini) saat masih antre
+            --PendingJobs;
+            return;
+        }
+        CurrentStopToken = Job.StopToken;
+    }
+
+    if (Job.Task)
+    {
+        Job.Task(*Job.StopToken, SearchThreads);
+
+        FScopeLock Lock(&CurrentJobLock);
+        CurrentStopToken.Reset();
+        --PendingJobs;
+        return;
+    }
+
+    if (!Job.Engine.IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("FMinimaxSearchWorker: Job tanpa Engine dibuang (Player %d)"), Job.PlayerTurn);
+
+        FScopeLock Lock(&CurrentJobLock);
+        CurrentStopToken.Reset();
+        --PendingJobs;
+        return;
+    }
+
+    // Dengan time control, Depth jadi batas atas iterative deepening yang dibatasi deadline token
+    Job.Engine->BeginGame(Job.GameId);
+    if (Job.TurnIndex != INDEX_NONE)
+        Job.Engine->BeginTurn(Job.TurnIndex);
+    Job.Engine->MaxSearchThreads = SearchThreads;
+    Job.Engine->SetProgressMailbox(Job.Progress.Get());
+    const FMinimaxResult Result = Job.bIterativeDeepening
+        ? Job.Engine->RunIterativeDeepening(Job.State, Job.Depth, Job.PlayerTurn, Job.AlgorithmChoice, Job.StopToken.Get())
+        : Job.Engine->RunSelectedAlgorithm(Job.State, Job.Depth, Job.PlayerTurn, Job.AlgorithmChoice, Job.StopToken.Get());
+    Job.Engine->SetProgressMailbox(nullptr);
+
+    {
+        FScopeLock Lock(&CurrentJobLock);
+        CurrentStopToken.Reset();
+    }
+    --PendingJobs;
+
+    // Hasil search yang dibatalkan tidak dikirim ke board (mungkin sudah selesai / di-destroy)
+    if (!Job.StopToken->IsCancelled() && Job.OnCompleteGameThread)
+    {
+        AsyncTask(ENamedThreads::GameThread, [OnComplete = MoveTemp(Job.OnCompleteGameThread), Result]()
+        {
+            OnComplete(Result);
+        });
+    }
+}
@@ -0,0 +1,109 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "MinimaxEngine.h"
+
+class FMinimaxSearchScheduler;
+
+//-----------------------------------------------------------------------------
+// FMinimaxSearchJob - One RunSelectedAlgorithm call plus the game-thread
+// callback that receives its result
+//-----------------------------------------------------------------------------
+struct FMinimaxSearchJob
+{
+    // Engine yang menjalankan search (TT / history milik pemain ini); wajib diisi untuk job search
+    TSharedPtr<MinimaxEngine> Engine;
+
+    FMinimaxState State;
+    int32 Depth = 1;
+    int32 PlayerTurn = 1;
+    int32 AlgorithmChoice = 1;
+
+    // AQuoridorBoard::GameId; engine mengosongkan TT / history / PV hanya jika game berganti
+    uint64 GameId = 0;
+
+    // TurnCount giliran yang dicari (ponder untuk giliran AI berikutnya memakai TurnCount + 1); MinimaxEngine::BeginTurn
+    // hanya bereaksi saat nilainya berganti. INDEX_NONE = tidak dicek
+    int32 TurnIndex = INDEX_NONE;
+
+    // True: RunIterativeDeepening sampai Depth, dipotong deadline di StopToken (time control)
+    bool bIterativeDeepening = false;
+
+    // Dipanggil di game thread setelah search selesai; caller wajib cek sendiri apakah board masih hidup
+    TFunction<void(const FMinimaxResult&)> OnCompleteGameThread;
+
+    // Diisi Enqueue jika kosong; search yang di-stop tidak pernah memanggil OnCompleteGameThread
+    TSharedPtr<FMinimaxStopToken> StopToken;
+
+    // Opsional: move terbaik sejauh ini / skor / depth / node count dipublikasikan ke sini selama search (polling dari game thread)
+    TSharedPtr<FMinimaxSearchProgress> Progress;
+
+    // Diisi Enqueue; job dari generasi sebelum CancelAll dibuang tanpa dicari
+    uint32 Generation = 0;
+
+    // Jika diisi, worker menjalankan Task (di thread pool) sebagai ganti satu search. Task mengecek
+    // token sendiri, memakai SearchThreadCap untuk engine-nya, dan mengirim hasilnya sendiri ke
+    // game thread; OnCompleteGameThread tidak dipakai.
+    TFunction<void(const FMinimaxStopToken& Stop, int32 SearchThreadCap)> Task;
+};
+
+//-----------------------------------------------------------------------------
+// FMinimaxSearchWorker - One board's search queue, served by the shared
+// FMinimaxSearchScheduler pool
+//
+// Dibuat sekali per board dan hidup sampai EndPlay. Board tidak lagi punya
+// thread sendiri: job diproses FIFO, satu per satu, oleh thread pool bersama
+// yang bergiliran adil antar board. Karena job satu board tidak pernah jalan
+// bersamaan, satu MinimaxEngine tidak pernah dipakai dua search sekaligus
+// dan cache-nya dipakai lagi antar search (lihat BeginTurn). Hasil dikirim
+// balik ke game thread lewat AsyncTask.
+//-----------------------------------------------------------------------------
+class QUORIDOR_API FMinimaxSearchWorker : public TSharedFromThis<FMinimaxSearchWorker>
+{
+public:
+    explicit FMinimaxSearchWorker(const FString& InName);
+    ~FMinimaxSearchWorker();
+
+    /** Game thread: antre satu search. Mengembalikan token untuk membatalkan job ini saja */
+    TSharedPtr<FMinimaxStopToken> Enqueue(FMinimaxSearchJob&& Job);
+
+    /** Membuang job yang antre dan menghentikan search yang sedang jalan (game selesai / game baru / unload) */
+    void CancelAll();
+
+    /** True selama masih ada job yang antre atau sedang dicari */
+    bool IsBusy() const { return PendingJobs.Load() > 0; }
+
+    /** CancelAll, lalu keluar dari scheduler dan menunggu job yang sedang jalan selesai. Wajib sebelum worker dilepas */
+    void Shutdown();
+
+    /** Batas thread ParallelFor per search board ini (algoritma 2 / 4); 0 = bagian adil core dari scheduler */
+    void SetSearchThreadCap(int32 InCap) { SearchThreadCap = FMath::Max(0, InCap); }
+    int32 GetSearchThreadCap() const { return SearchThreadCap.Load(); }
+
+    const FString& GetName() const { return Name; }
+
+private:
+    friend class FMinimaxSearchScheduler;
+
+    /** Thread pool: jalankan job berikutnya (tidak pernah paralel untuk worker yang sama) */
+    void RunNextJob(int32 SearchThreads);
+
+    /** Dipanggil scheduler di bawah lock-nya saat worker tidak sedang dijalankan */
+    bool HasQueuedJobs() const { return !bStopping.Load() && !Jobs.IsEmpty(); }
+
+    FString Name;
+    TSharedPtr<FMinimaxSearchScheduler> Scheduler;
+
+    TQueue<FMinimaxSearchJob, EQueueMode::Mpsc> Jobs;
+    TAtomic<bool> bStopping{ false };
+    TAtomic<int32> PendingJobs{ 0 };
+    TAtomic<int32> SearchThreadCap{ 0 };
+
+    // Naik setiap CancelAll; queue MPSC hanya di-dequeue oleh job yang sedang dijadwalkan
+    TAtomic<uint32> CancelGeneration{ 0 };
+
+    // Token job yang sedang dicari, dibaca CancelAll dari game thread
+    FCriticalSection CurrentJobLock;
+    TSharedPtr<FMinimaxStopToken> CurrentStopToken;
+};
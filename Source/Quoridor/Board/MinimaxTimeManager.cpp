@@ -0,0 +1,77 @@
+﻿// MinimaxTimeManager.cpp
+#include "MinimaxTimeManager.h"
+#include "MinimaxEngine.h"
+
+void FMinimaxTimeManager::Reset(float BaseSeconds, float IncrementSeconds)
+{
+    bEnabled = BaseSeconds > 0.f;
+    Increment = FMath::Max(0.0, static_cast<double>(IncrementSeconds));
+    for (int32 idx = 0; idx < 2; ++idx)
+    {
+        Remaining[idx] = FMath::Max(0.0, static_cast<double>(BaseSeconds));
+        LastScore[idx] = 0;
+        LastSwing[idx] = 0;
+        bHasLastScore[idx] = false;
+    }
+}
+
+int32 FMinimaxTimeManager::EstimateMovesToGo(const FMinimaxState& S, int32 PlayerNum)
+{
+    // Kira-kira: langkah pion ke goal + wall yang masih mungkin dipasang, di-clamp supaya awal game tidak terlalu pelit
+    int32 PathLength = 100;
+    MinimaxEngine::ComputePathToGoal(S, PlayerNum, &PathLength);
+    if (PathLength >= 100)
+        PathLength = 8;
+
+    const int32 WallMoves = S.WallsRemaining[PlayerNum - 1] / 2;
+    return FMath::Clamp(PathLength + WallMoves, 4, 30);
+}
+
+double FMinimaxTimeManager::AllocateMoveBudget(int32 PlayerNum, const FMinimaxState& S) const
+{
+    if (!bEnabled || PlayerNum < 1 || PlayerNum > 2)
+        return 0.0;
+
+    const int32 idx = PlayerNum - 1;
+    const double Clock = Remaining[idx];
+
+    double Budget = Clock / EstimateMovesToGo(S, PlayerNum) + Increment * 0.8;
+
+    // Branching factor: 20 kandidat dianggap normal, skala sqrt supaya tidak ekstrem
+    const int32 Branching = MinimaxEngine::GetPawnMoves(S, PlayerNum).Num() +
+        (S.WallsRemaining[idx] > 0 ? MinimaxEngine::GetAllUsefulWallPlacements(S, PlayerNum).Num() : 0);
+    Budget *= FMath::Clamp(FMath::Sqrt(Branching / 20.0), 0.6, 1.6);
+
+    // Stabilitas skor: evaluasi yang baru saja berubah banyak butuh search lebih lama
+    if (bHasLastScore[idx])
+    {
+        Budget *= (LastSwing[idx] > UnstableScoreSwing) ? 1.3 : 0.85;
+    }
+
+    const double Cap = FMath::Max(MinMoveBudget, Clock * MaxFractionOfClock - SafetyMargin);
+    return FMath::Clamp(Budget, MinMoveBudget, Cap);
+}
+
+void FMinimaxTimeManager::FinishMove(int32 PlayerNum, double ElapsedSeconds, int32 Score)
+{
+    if (!bEnabled || PlayerNum < 1 || PlayerNum > 2)
+        return;
+
+    const int32 idx = PlayerNum - 1;
+    Remaining[idx] = Remaining[idx] - ElapsedSeconds;
+    if (Remaining[idx] <= 0.0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[TimeControl] Player %d kehabisan waktu (%.3f s)"), PlayerNum, Remaining[idx]);
+        Remaining[idx] = 0.0;
+    }
+    Remaining[idx] += Increment;
+
+    LastSwing[idx] = bHasLastScore[idx] ? FMath::Abs(Score - LastScore[idx]) : 0;
+    LastScore[idx] = Score;
+    bHasLastScore[idx] = true;
+}
+
+double FMinimaxTimeManager::GetRemainingSeconds(int32 PlayerNum) const
+{
+    return (PlayerNum >= 1 && PlayerNum <= 2) ? Remaining[PlayerNum - 1] : 0.0;
+}
@@ -0,0 +1,48 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMinimaxState;
+
+//-----------------------------------------------------------------------------
+// FMinimaxTimeManager - Game clock (base + increment) for the AI players and
+// per-move budget allocation
+//
+// Budget per langkah = waktu sisa / perkiraan langkah tersisa + sebagian
+// increment, lalu diskalakan dengan branching factor posisi (banyak kandidat
+// wall -> butuh lebih lama) dan stabilitas skor (skor yang loncat-loncat
+// antar langkah -> beri waktu lebih). Budget ditegakkan lewat deadline di
+// FMinimaxStopToken + RunIterativeDeepening.
+//-----------------------------------------------------------------------------
+class QUORIDOR_API FMinimaxTimeManager
+{
+public:
+    /** BaseSeconds <= 0 mematikan time control (search memakai Depth penuh tanpa deadline) */
+    void Reset(float BaseSeconds, float IncrementSeconds);
+
+    bool IsEnabled() const { return bEnabled; }
+
+    /** Budget (detik) untuk langkah PlayerNum di posisi S */
+    double AllocateMoveBudget(int32 PlayerNum, const FMinimaxState& S) const;
+
+    /** Potong jam pemain, tambah increment, dan catat skor untuk stabilitas */
+    void FinishMove(int32 PlayerNum, double ElapsedSeconds, int32 Score);
+
+    double GetRemainingSeconds(int32 PlayerNum) const;
+
+    /** Perkiraan langkah tersisa untuk PlayerNum, dipakai sebagai pembagi waktu sisa */
+    static int32 EstimateMovesToGo(const FMinimaxState& S, int32 PlayerNum);
+
+    static constexpr double MinMoveBudget = 0.05;    // detik, selalu cukup untuk depth 1
+    static constexpr double SafetyMargin = 0.05;     // detik, cadangan overhead game thread
+    static constexpr double MaxFractionOfClock = 0.4;
+    static constexpr int32 UnstableScoreSwing = 50;  // |skor - skor sebelumnya| di atas ini dianggap tidak stabil
+
+private:
+    bool bEnabled = false;
+    double Increment = 0.0;
+    double Remaining[2] = { 0.0, 0.0 };
+    int32 LastScore[2] = { 0, 0 };
+    int32 LastSwing[2] = { 0, 0 };
+    bool bHasLastScore[2] = { false, false };
+};
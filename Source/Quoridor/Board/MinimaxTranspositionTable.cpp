@@ -0,0 +1,143 @@
+﻿// MinimaxTranspositionTable.cpp
+#include "MinimaxTranspositionTable.h"
+#include "MinimaxEngine.h"
+#include "Hash/CityHash.h"
+
+FMinimaxTranspositionTable::FMinimaxTranspositionTable(int32 SizeMB)
+{
+    Resize(SizeMB);
+}
+
+void FMinimaxTranspositionTable::Resize(int32 SizeMB)
+{
+    const uint64 Bytes = static_cast<uint64>(FMath::Max(1, SizeMB)) * 1024 * 1024;
+    const uint64 NumSlots = FMath::RoundUpToPowerOfTwo64(Bytes / sizeof(FSlot) + 1) >> 1;
+
+    Slots = MakeUnique<FSlot[]>(NumSlots);
+    SlotMask = NumSlots - 1;
+    Generation = 0;
+}
+
+void FMinimaxTranspositionTable::Clear()
+{
+    for (uint64 i = 0; i <= SlotMask; ++i)
+    {
+        Slots[i].KeyXorData.Store(0, EMemoryOrder::Relaxed);
+        Slots[i].Data.Store(0, EMemoryOrder::Relaxed);
+    }
+    Generation = 0;
+}
+
+void FMinimaxTranspositionTable::NewGeneration()
+{
+    Generation = (Generation + 1) & GenerationMask;
+    if (Generation == 0)
+    {
+        DemoteAllToHints();
+    }
+}
+
+void FMinimaxTranspositionTable::DemoteAllToHints()
+{
+    // Hanya dipanggil di root sebelum search mulai, jadi tidak ada Store yang bersamaan
+    constexpr uint64 KeepMask = (0xFFFFull << 32) | (static_cast<uint64>(GenerationMask) << 58); // action + generation
+    for (uint64 i = 0; i <= SlotMask; ++i)
+    {
+        const uint64 Data = Slots[i].Data.Load(EMemoryOrder::Relaxed);
+        if (Data == 0)
+            continue;
+
+        const uint64 Key = Slots[i].KeyXorData.Load(EMemoryOrder::Relaxed) ^ Data;
+        const uint64 Demoted = Data & KeepMask;
+        Slots[i].KeyXorData.Store(Key ^ Demoted, EMemoryOrder::Relaxed);
+        Slots[i].Data.Store(Demoted, EMemoryOrder::Relaxed);
+    }
+}
+
+bool FMinimaxTranspositionTable::Probe(uint64 Key, FMinimaxTTEntry& OutEntry) const
+{
+    const FSlot& Slot = Slots[Key & SlotMask];
+    const uint64 Data = Slot.Data.Load(EMemoryOrder::Relaxed);
+    if ((Slot.KeyXorData.Load(EMemoryOrder::Relaxed) ^ Data) != Key)
+        return false;
+
+    OutEntry.Bound = static_cast<EMinimaxBound>((Data >> 56) & 0x3);
+    OutEntry.PackedAction = static_cast<uint16>(Data >> 32);
+    if (OutEntry.Bound == EMinimaxBound::None && OutEntry.PackedAction == 0)
+        return false;
+
+    OutEntry.Value = static_cast<int32>(static_cast<uint32>(Data));
+    OutEntry.Depth = static_cast<int32>((Data >> 48) & 0xFF);
+    OutEntry.Generation = static_cast<uint8>(Data >> 58);
+    return true;
+}
+
+void FMinimaxTranspositionTable::Store(uint64 Key, int32 Value, int32 Depth, EMinimaxBound Bound, uint16 PackedAction)
+{
+    FSlot& Slot = Slots[Key & SlotMask];
+    const uint64 OldData = Slot.Data.Load(EMemoryOrder::Relaxed);
+    if (OldData != 0)
+    {
+        const uint64 OldKey = Slot.KeyXorData.Load(EMemoryOrder::Relaxed) ^ OldData;
+        const uint8 OldGeneration = static_cast<uint8>(OldData >> 58);
+        const EMinimaxBound OldBound = static_cast<EMinimaxBound>((OldData >> 56) & 0x3);
+        const int32 OldDepth = static_cast<int32>((OldData >> 48) & 0xFF);
+
+        if (OldKey == Key)
+        {
+            // Posisi yang sama tanpa move baru (mis. fail-low): move lama tetap dipakai untuk ordering
+            if (PackedAction == 0)
+                PackedAction = static_cast<uint16>(OldData >> 32);
+        }
+        else if (OldGeneration == Generation && OldBound != EMinimaxBound::None && OldDepth > Depth)
+        {
+            // Entry generasi ini yang lebih dalam lebih berharga; generasi lama dan hint selalu boleh ditimpa
+            return;
+        }
+    }
+
+    const uint64 Data =
+        static_cast<uint64>(static_cast<uint32>(Value)) |
+        (static_cast<uint64>(PackedAction) << 32) |
+        (static_cast<uint64>(FMath::Clamp(Depth, 0, 255)) << 48) |
+        (static_cast<uint64>(Bound) << 56) |
+        (static_cast<uint64>(Generation & GenerationMask) << 58);
+
+    Slot.KeyXorData.Store(Key ^ Data, EMemoryOrder::Relaxed);
+    Slot.Data.Store(Data, EMemoryOrder::Relaxed);
+}
+
+uint64 FMinimaxTranspositionTable::HashState(const FMinimaxState& S, int32 SideToMove, int32 RootPlayer)
+{
+    // Semua field sebelum Accumulator: pion, riwayat pion, inventory dan wall (tanpa padding)
+    const uint64 Seed = static_cast<uint64>(SideToMove) | (static_cast<uint64>(RootPlayer) << 2);
+    return CityHash64WithSeed(reinterpret_cast<const char*>(&S), STRUCT_OFFSET(FMinimaxState, Accumulator), Seed);
+}
+
+uint16 FMinimaxTranspositionTable::EncodeAction(const FMinimaxAction& Act)
+{
+    // bit 0 = valid, 1 = wall, 2..5 = X, 6..9 = Y, 10..11 = length, 12 = horizontal
+    if (Act.bIsWall)
+    {
+        if (Act.SlotX < 0 || Act.SlotY < 0 || Act.WallLength < 1)
+            return 0;
+        return static_cast<uint16>(1 | (1 << 1) | (Act.SlotX << 2) | (Act.SlotY << 6) |
+                                   (Act.WallLength << 10) | ((Act.bHorizontal ? 1 : 0) << 12));
+    }
+
+    if (Act.MoveX < 0 || Act.MoveY < 0)
+        return 0;
+    return static_cast<uint16>(1 | (Act.MoveX << 2) | (Act.MoveY << 6));
+}
+
+FMinimaxAction FMinimaxTranspositionTable::DecodeAction(uint16 PackedAction)
+{
+    if ((PackedAction & 1) == 0)
+        return FMinimaxAction();
+
+    const int32 X = (PackedAction >> 2) & 0xF;
+    const int32 Y = (PackedAction >> 6) & 0xF;
+    if (PackedAction & (1 << 1))
+        return FMinimaxAction(X, Y, (PackedAction >> 10) & 0x3, (PackedAction & (1 << 12)) != 0);
+    return FMinimaxAction(X, Y);
+}
@@ -0,0 +1,83 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMinimaxState;
+struct FMinimaxAction;
+
+enum class EMinimaxBound : uint8
+{
+    None  = 0,
+    Exact = 1,
+    Lower = 2, // Value adalah batas bawah (fail-high / beta cutoff)
+    Upper = 3  // Value adalah batas atas (fail-low)
+};
+
+/** Isi satu entry yang ditemukan Probe */
+struct FMinimaxTTEntry
+{
+    int32 Value = 0;
+    int32 Depth = 0;
+    EMinimaxBound Bound = EMinimaxBound::None;
+    uint8 Generation = 0;
+    uint16 PackedAction = 0; // FMinimaxTranspositionTable::EncodeAction, 0 = tidak ada
+};
+
+// Bound None + action: hint move saja (PV giliran lalu / entry yang sudah di-age), tidak pernah dipakai untuk cutoff
+
+//-----------------------------------------------------------------------------
+// FMinimaxTranspositionTable - Lockless hash table of searched nodes
+//
+// Dimiliki satu MinimaxEngine. Setiap slot adalah dua uint64 (Key ^ Data, Data),
+// jadi Probe dari thread lain (ParallelFor di algoritma 4) yang membaca slot
+// setengah tertulis hanya mendapat miss, bukan data yang salah.
+//
+// Data: [0..31] Value, [32..47] action, [48..55] depth, [56..57] bound,
+//       [58..63] generation.
+//
+// Isi tabel tidak dikosongkan antar giliran. Store mempertahankan entry yang
+// lebih dalam dari generasi yang sama dan selalu boleh menimpa generasi lama,
+// jadi entry giliran lalu menua dan tergeser alami sambil tetap memberi move
+// untuk ordering selama masih ada.
+//-----------------------------------------------------------------------------
+class FMinimaxTranspositionTable
+{
+public:
+    explicit FMinimaxTranspositionTable(int32 SizeMB);
+
+    /** Mengalokasikan ulang (isi hilang); ukuran dibulatkan ke bawah ke pangkat dua slot */
+    void Resize(int32 SizeMB);
+    void Clear();
+
+    /**
+     * Dipanggil saat root search berganti; entry generasi lain tidak dipakai untuk cutoff. Saat nomor generasi
+     * berputar kembali ke 0, semua entry diturunkan jadi hint move supaya bound 64 root lalu tidak terbaca sebagai generasi ini.
+     */
+    void NewGeneration();
+    uint8 GetGeneration() const { return Generation; }
+
+    bool Probe(uint64 Key, FMinimaxTTEntry& OutEntry) const;
+    void Store(uint64 Key, int32 Value, int32 Depth, EMinimaxBound Bound, uint16 PackedAction);
+
+    /** Key posisi (tanpa Accumulator) + pemain yang jalan + pemain root (sudut pandang Evaluate) */
+    static uint64 HashState(const FMinimaxState& S, int32 SideToMove, int32 RootPlayer);
+
+    static uint16 EncodeAction(const FMinimaxAction& Act);
+    static FMinimaxAction DecodeAction(uint16 PackedAction);
+
+    static constexpr uint8 GenerationMask = 0x3F;
+
+private:
+    struct FSlot
+    {
+        TAtomic<uint64> KeyXorData{ 0 };
+        TAtomic<uint64> Data{ 0 };
+    };
+
+    /** Semua entry jadi Bound None / depth 0, action dan key dipertahankan */
+    void DemoteAllToHints();
+
+    TUniquePtr<FSlot[]> Slots;
+    uint64 SlotMask = 0;
+    uint8 Generation = 0;
+};
@@ -7,6 +7,7 @@
 #include "Quoridor/Wall/WallSlot.h"
 #include "Quoridor/Wall/WallDefinition.h"
 #include "Quoridor/Board/MinimaxBoardAI.h"
+#include "Quoridor/Board/MinimaxSearchWorker.h"
 #include "Kismet/GameplayStatics.h"
 #include "Quoridor/Tile/Tile.h"
 #include "Engine/World.h"
@@ -15,20 +16,74 @@
 #include "Containers/Queue.h"
 #include "Containers/Set.h"
 #include "Algo/Reverse.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Components/BoxComponent.h"
+#include "GameFramework/PlayerController.h"
 
 class AWallPreview;
 
 AQuoridorBoard::AQuoridorBoard()
 {
+	// Tidak ada yang dianimasikan per frame; giliran & HUD digerakkan oleh OnTurnChanged
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 	CurrentPlayerTurn = 1;
+
+	BoardRoot = CreateDefaultSubobject<USceneComponent>(TEXT("BoardRoot"));
+	RootComponent = BoardRoot;
+
+	// Custom data [0]: PlayerNumber pemilik wall
+	WallInstances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("WallInstances"));
+	WallInstances->SetupAttachment(BoardRoot);
+	WallInstances->NumCustomDataFloats = 1;
+	WallInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	// Custom data [0]: ETileHighlight; klik tetap ditangani oleh actor ATile
+	TileInstances = CreateDefaultSubobject<UHierarchicalInstancedStaticMeshComponent>(TEXT("TileInstances"));
+	TileInstances->SetupAttachment(BoardRoot);
+	TileInstances->NumCustomDataFloats = 1;
+	TileInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	// Hanya memblok Visibility selama penempatan wall (SetWallPickingActive), jadi klik tile tidak terhalang
+	WallPickingVolume = CreateDefaultSubobject<UBoxComponent>(TEXT("WallPickingVolume"));
+	WallPickingVolume->SetupAttachment(BoardRoot);
+	WallPickingVolume->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	WallPickingVolume->SetCollisionObjectType(ECollisionChannel::ECC_WorldStatic);
+	WallPickingVolume->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
+	WallPickingVolume->SetGenerateOverlapEvents(false);
+}
+void AQuoridorBoard::EndTurn(int32 ActingPlayer)
+{
+	CurrentPlayerTurn = (ActingPlayer == 1) ? 2 : 1;
+	TurnCount++;
+
+	if (!bDeferPresentation)
+	{
+		ShowTurnMessage();
+	}
+	OnTurnChanged.Broadcast(CurrentPlayerTurn, TurnCount);
 }
-void AQuoridorBoard::Tick(float DeltaTime)
+
+void AQuoridorBoard::FlushDeferredPresentation()
 {
-	Super::Tick(DeltaTime);
+	for (const FDeferredWallVisual& Wall : DeferredWallVisuals)
+	{
+		SpawnPlacedWallVisuals(Wall.BaseLocation, Wall.bHorizontal, Wall.Length, Wall.PlayerNumber);
+	}
+	DeferredWallVisuals.Reset();
+
+	ShowTurnMessage();
+}
 
-	GEngine->AddOnScreenDebugMessage(1, 0.0f, FColor::Cyan,
-		FString::Printf(TEXT("Turn: Player %d"), CurrentPlayerTurn));
+void AQuoridorBoard::ShowTurnMessage() const
+{
+	// Key 1 menimpa pesan sebelumnya, jadi cukup ditulis sekali per giliran
+	if (GEngine)
+	{
+		GEngine->AddOnScreenDebugMessage(1, TNumericLimits<float>::Max(), FColor::Cyan,
+			FString::Printf(TEXT("Turn: Player %d"), CurrentPlayerTurn));
+	}
 }
 
 
@@ -42,6 +97,7 @@ void AQuoridorBoard::BeginPlay()
 	const FVector BoardCenter = GetActorLocation();
 	bIsGameFinished = false;
 	WinningTurn = 0;
+	ResetBoardModel();
 
 	// // North Wall
 	// SpawnWall(BoardCenter + FVector(0.0f, BoardHalfLength + HalfTileSize, 0.0f), FRotator::ZeroRotator, FVector(GridSize, 1, 1));
@@ -55,78 +111,181 @@ void AQuoridorBoard::BeginPlay()
 	// // West Wall
 	// SpawnWall(BoardCenter + FVector(-BoardHalfLength - HalfTileSize, 0.0f, 0.0f), FRotator(0.0f, 90.0f, 0.0f), FVector(GridSize + 1.32, 1, 1));
     
-	// Initialize tiles
+	// Initialize instanced meshes (tile di-spawn oleh StepBoardConstruction)
+	if (TileInstances && TileInstanceMesh)
+	{
+		TileInstances->SetStaticMesh(TileInstanceMesh);
+		TileInstances->ClearInstances();
+	}
+	if (WallInstances && WallSegmentMesh)
+	{
+		WallInstances->SetStaticMesh(WallSegmentMesh);
+		WallInstances->ClearInstances();
+	}
+
+	// Volume picking menutupi seluruh grid tile
+	WallPickingVolume->SetWorldLocation(BoardCenter);
+	WallPickingVolume->SetBoxExtent(FVector(BoardHalfLength, BoardHalfLength, 10.0f));
+	WallPickingVolume->OnClicked.AddDynamic(this, &AQuoridorBoard::OnWallPickingClicked);
+
+	// Tile di-spawn bertahap mulai tick berikutnya (subclass AI sudah selesai BeginPlay),
+	// lalu FinishBoardConstruction menyiapkan koneksi & pion dan mem-broadcast OnBoardReady
 	Tiles.SetNum(GridSize);
-	for(int32 y = 0; y < GridSize; y++)
+	for (int32 y = 0; y < GridSize; ++y)
 	{
-		Tiles[y].SetNum(GridSize);
-		for(int32 x = 0; x < GridSize; x++)
-		{
-			// Calculate position relative to board center
-			const FVector TileLocation = BoardCenter + FVector(
-				(x - GridSize/2) * TileSize,
-				(y - GridSize/2) * TileSize,
-				0
-			);
-
-			ATile* NewTile = GetWorld()->SpawnActor<ATile>(TileClass, TileLocation, FRotator::ZeroRotator);
-			NewTile->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
-			NewTile->SetGridPosition(x, y);
-			Tiles[y][x] = NewTile;
-		}
+		Tiles[y].Init(nullptr, GridSize);
 	}
+	ConstructionCursor = 0;
+	bBoardReady = false;
+	GetWorldTimerManager().SetTimerForNextTick(this, &AQuoridorBoard::StepBoardConstruction);
+}
 
-	// Spawn pawns after board is fully initialized
-	FTimerHandle SpawnDelayHandle;
-	GetWorldTimerManager().SetTimer(SpawnDelayHandle, [this]()
+void AQuoridorBoard::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Batalkan search yang sedang berjalan lalu keluar dari thread pool sebelum board hilang
+	if (SearchWorker.IsValid())
 	{
-		SpawnPawn(FIntPoint(4, 0), 1); // Player 1
-		SpawnPawn(FIntPoint(4, 8), 2); // Player 2
-	}, 0.1f, false);
+		SearchWorker->Shutdown();
+		SearchWorker.Reset();
+	}
+	SearchEngines[0].Reset();
+	SearchEngines[1].Reset();
 
-	for (int32 y = 0; y < GridSize - 1; ++y)
+	Super::EndPlay(EndPlayReason);
+}
+
+FMinimaxSearchWorker& AQuoridorBoard::GetSearchWorker()
 {
-    for (int32 x = 0; x < GridSize; ++x)
-    {
-        const FVector Loc = Tiles[y][x]->GetActorLocation() + FVector(0, TileSize / 2, 0);
-        AWallSlot* Slot = GetWorld()->SpawnActor<AWallSlot>(WallSlotClass, Loc, FRotator::ZeroRotator);
-        Slot->Orientation = EWallOrientation::Horizontal;
-        Slot->SetGridPosition(x, y);
-        WallSlots.Add(Slot);
-    }
+	if (!SearchWorker.IsValid())
+	{
+		SearchWorker = MakeShared<FMinimaxSearchWorker>(FString::Printf(TEXT("MinimaxSearch_%s"), *GetName()));
+	}
+	SearchWorker->SetSearchThreadCap(SearchThreadCap);
+	return *SearchWorker;
 }
-	// Spawn wall slots (horizontal)
-	for (int32 y = 0; y < GridSize - 1; ++y)
+
+TSharedPtr<MinimaxEngine> AQuoridorBoard::GetSearchEngine(int32 PlayerNum)
+{
+	const int32 idx = FMath::Clamp(PlayerNum, 1, 2) - 1;
+	if (!SearchEngines[idx].IsValid())
 	{
-		for (int32 x = 0; x < GridSize; ++x)
+		SearchEngines[idx] = MakeShared<MinimaxEngine>(TranspositionTableSizeMB);
+		SearchEngines[idx]->bKeepCachesAcrossTurns = bKeepSearchCachesAcrossTurns;
+		SearchEngines[idx]->bUseBoardControlTerm = bUseBoardControlTerm;
+		SearchEngines[idx]->bEnableSingleSidedSearch = bEnableSingleSidedSearch;
+
+		if (bUseLearnedEvaluator)
 		{
-			const FVector Loc = Tiles[y][x]->GetActorLocation() + FVector(0, TileSize / 2, 0);
-			AWallSlot* Slot = GetWorld()->SpawnActor<AWallSlot>(WallSlotClass, Loc, FRotator::ZeroRotator);
-			Slot->Orientation = EWallOrientation::Horizontal;
-			Slot->SetGridPosition(x, y);
-			Slot->Board = this;
-			WallSlots.Add(Slot);
-			HorizontalWallSlots.Add(Slot); 
+			// Bobot dibaca sekali per board; engine pemain lain memakai network yang sama (read-only saat search)
+			const TSharedPtr<MinimaxEngine>& Other = SearchEngines[1 - idx];
+			if (Other.IsValid() && Other->LearnedEvaluator.IsValid())
+			{
+				SearchEngines[idx]->LearnedEvaluator = Other->LearnedEvaluator;
+			}
+			else if (!SearchEngines[idx]->LoadLearnedEvaluator(FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), LearnedEvaluatorWeightsPath)))
+			{
+				UE_LOG(LogTemp, Error, TEXT("[%s] Learned evaluator '%s' gagal dimuat, pakai Evaluate"), *GetName(), *LearnedEvaluatorWeightsPath);
+			}
+			SearchEngines[idx]->bUseLearnedEvaluator = true;
 		}
 	}
+	return SearchEngines[idx];
+}
 
-	// Spawn wall slots (vertical)
-	for (int32 y = 0; y < GridSize; ++y)
+//-----------------------------------------------------------------------------
+// Konstruksi papan bertahap: maks. TileSpawnBudgetPerFrame tile per frame
+//-----------------------------------------------------------------------------
+FVector AQuoridorBoard::GetTileWorldLocation(int32 X, int32 Y) const
+{
+	// Calculate position relative to board center
+	return GetActorLocation() + FVector(
+		(X - GridSize/2) * TileSize,
+		(Y - GridSize/2) * TileSize,
+		0
+	);
+}
+
+void AQuoridorBoard::StepBoardConstruction()
+{
+	const int32 TotalTiles = GridSize * GridSize;
+	const int32 Budget = TileSpawnBudgetPerFrame > 0 ? TileSpawnBudgetPerFrame : TotalTiles;
+	const int32 End = FMath::Min(ConstructionCursor + Budget, TotalTiles);
+	const bool bInstancedTiles = TileInstances && TileInstanceMesh;
+
+	for (; ConstructionCursor < End; ++ConstructionCursor)
 	{
-		for (int32 x = 0; x < GridSize - 1; ++x)
+		const int32 x = ConstructionCursor % GridSize;
+		const int32 y = ConstructionCursor / GridSize;
+		const FVector TileLocation = GetTileWorldLocation(x, y);
+
+		ATile* NewTile = GetWorld()->SpawnActor<ATile>(TileClass, TileLocation, FRotator::ZeroRotator);
+		NewTile->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
+		NewTile->SetGridPosition(x, y);
+		Tiles[y][x] = NewTile;
+
+		// Instance index = y * GridSize + x; actor tile tetap ada sebagai target klik
+		if (bInstancedTiles)
 		{
-			const FVector Loc = Tiles[y][x]->GetActorLocation() + FVector(TileSize / 2, 0, 0);
-			AWallSlot* Slot = GetWorld()->SpawnActor<AWallSlot>(WallSlotClass, Loc, FRotator(0, 90, 0));
-			Slot->Orientation = EWallOrientation::Vertical;
-			Slot->SetGridPosition(x, y);
-			Slot->Board = this;
-			WallSlots.Add(Slot);
-			VerticalWallSlots.Add(Slot); 
+			TileInstances->AddInstance(FTransform(FRotator::ZeroRotator, TileLocation, TileInstanceScale), true);
+			NewTile->SetVisualMeshHidden(true);
 		}
 	}
 
+	if (ConstructionCursor < TotalTiles)
+	{
+		GetWorldTimerManager().SetTimerForNextTick(this, &AQuoridorBoard::StepBoardConstruction);
+		return;
+	}
+
+	FinishBoardConstruction();
+}
+
+void AQuoridorBoard::FinishBoardConstruction()
+{
+	// Grid AWallSlot lama hanya untuk Blueprint yang belum pindah ke WallPickingVolume
+	if (bSpawnLegacyWallSlots && WallSlotClass)
+	{
+		// Spawn wall slots (horizontal)
+		for (int32 y = 0; y < GridSize - 1; ++y)
+		{
+			for (int32 x = 0; x < GridSize; ++x)
+			{
+				AWallSlot* Slot = GetWorld()->SpawnActor<AWallSlot>(WallSlotClass, GetWallSlotWorldLocation(x, y, EWallOrientation::Horizontal), FRotator::ZeroRotator);
+				Slot->Orientation = EWallOrientation::Horizontal;
+				Slot->SetGridPosition(x, y);
+				Slot->Board = this;
+				WallSlots.Add(Slot);
+				HorizontalWallSlots.Add(Slot); 
+			}
+		}
+
+		// Spawn wall slots (vertical)
+		for (int32 y = 0; y < GridSize; ++y)
+		{
+			for (int32 x = 0; x < GridSize - 1; ++x)
+			{
+				AWallSlot* Slot = GetWorld()->SpawnActor<AWallSlot>(WallSlotClass, GetWallSlotWorldLocation(x, y, EWallOrientation::Vertical), FRotator(0, 90, 0));
+				Slot->Orientation = EWallOrientation::Vertical;
+				Slot->SetGridPosition(x, y);
+				Slot->Board = this;
+				WallSlots.Add(Slot);
+				VerticalWallSlots.Add(Slot); 
+			}
+		}
+	}
+
+	BuildWallSlotIndex();
 	UpdateAllTileConnections();
-	
+	EnsureWallPreviewPool();
+
+	// Spawn pawns after board is fully initialized
+	SpawnPawn(FIntPoint(4, 0), 1); // Player 1
+	SpawnPawn(FIntPoint(4, 8), 2); // Player 2
+
+	bBoardReady = true;
+	ShowTurnMessage();
+	UE_LOG(LogTemp, Log, TEXT("%s: board ready (%d tiles)"), *GetName(), GridSize * GridSize);
+	OnBoardReady.Broadcast(this);
 }
 
 void AQuoridorBoard::SpawnPawn(FIntPoint GridPosition, int32 PlayerNumber)
@@ -158,7 +317,12 @@ void AQuoridorBoard::SpawnPawn(FIntPoint GridPosition, int32 PlayerNumber)
                     RandomWalls.Add(NewWall);
                 }
 
-                NewPawn->PlayerWalls = RandomWalls;
+                NewPawn->SetPlayerWalls(RandomWalls);
+                if (PlayerNumber == 1 || PlayerNumber == 2)
+                {
+                    PlayerPawns[PlayerNumber - 1] = NewPawn;
+                }
+                SyncPawnToModel(NewPawn);
             	if (AAI_VS_AI* AI = Cast<AAI_VS_AI>(this))
             	{
             		if (PlayerNumber == AI->AI1Player || PlayerNumber == AI->AI2Player)
@@ -202,6 +366,7 @@ void AQuoridorBoard::HandlePawnClick(AQuoridorPawn* ClickedPawn)
 
 	// Pilih pion untuk digerakkan atau untuk menempatkan tembok
 	SelectedPawn = ClickedPawn;
+	HighlightLegalMoves();
 }
 
 void AQuoridorBoard::HandleTileClick(ATile* ClickedTile)
@@ -228,8 +393,7 @@ void AQuoridorBoard::HandleTileClick(ATile* ClickedTile)
 		SelectedPawn->MoveToTile(ClickedTile, false);
 
 		// Ganti giliran
-		CurrentPlayerTurn = (CurrentPlayerTurn == 1) ? 2 : 1;
-		TurnCount++;
+		EndTurn(CurrentPlayerTurn);
 
 		// Bersihkan seleksi HANYA SETELAH aksi berhasil
 		ClearSelection();
@@ -253,6 +417,61 @@ void AQuoridorBoard::ClearSelection()
 {
 	SelectedPawn = nullptr;
 	// Unhighlight all tiles
+	ClearTileHighlights();
+}
+
+void AQuoridorBoard::SpawnPlacedWallVisuals(const FVector& BaseLocation, bool bHorizontal, int32 Length, int32 PlayerNumber)
+{
+	const FRotator WallRotation = bHorizontal ? FRotator::ZeroRotator : FRotator(0, 90, 0);
+	const bool bInstanced = WallInstances && WallSegmentMesh;
+
+	for (int32 i = 0; i < Length; ++i)
+	{
+		const FVector SegmentLocation = BaseLocation + (bHorizontal
+			? FVector(i * TileSize, 0, 0)
+			: FVector(0, i * TileSize, 0));
+
+		if (bInstanced)
+		{
+			const int32 Instance = WallInstances->AddInstance(FTransform(WallRotation, SegmentLocation, WallSegmentScale), true);
+			WallInstances->SetCustomDataValue(Instance, 0, static_cast<float>(PlayerNumber), true);
+			continue;
+		}
+
+		AActor* NewWall = GetWorld()->SpawnActor<AActor>(WallPlacementClass, SegmentLocation, WallRotation);
+		if (NewWall)
+		{
+			NewWall->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
+		}
+	}
+}
+
+void AQuoridorBoard::SetTileHighlight(int32 X, int32 Y, ETileHighlight Highlight)
+{
+	if (!TileInstances || !TileInstanceMesh || X < 0 || Y < 0 || X >= GridSize || Y >= GridSize)
+	{
+		return;
+	}
+
+	const int32 Instance = Y * GridSize + X;
+	if (Instance < TileInstances->GetInstanceCount())
+	{
+		TileInstances->SetCustomDataValue(Instance, 0, static_cast<float>(Highlight), true);
+	}
+}
+
+void AQuoridorBoard::ClearTileHighlights()
+{
+	if (!TileInstances || !TileInstanceMesh)
+	{
+		return;
+	}
+
+	const int32 Count = TileInstances->GetInstanceCount();
+	for (int32 Instance = 0; Instance < Count; ++Instance)
+	{
+		TileInstances->SetCustomDataValue(Instance, 0, 0.0f, Instance == Count - 1);
+	}
 }
 
 void AQuoridorBoard::SpawnWall(FVector Location, FRotator Rotation, FVector Scale)
@@ -268,7 +487,26 @@ void AQuoridorBoard::SpawnWall(FVector Location, FRotator Rotation, FVector Scal
 
 bool AQuoridorBoard::TryPlaceWall(AWallSlot* StartSlot, int32 WallLength)
 {
-    if (!StartSlot || WallLength == 0)
+    if (!StartSlot)
+    {
+       return false;
+    }
+    return TryPlaceWallAt(StartSlot->GridX, StartSlot->GridY, StartSlot->Orientation, WallLength);
+}
+
+bool AQuoridorBoard::TryPlaceWallAtWorldLocation(const FVector& WorldLocation)
+{
+    int32 SlotX, SlotY;
+    if (!PickWallSlotFromWorld(WorldLocation, PendingWallOrientation, SlotX, SlotY))
+    {
+       return false;
+    }
+    return TryPlaceWallAt(SlotX, SlotY, PendingWallOrientation, PendingWallLength);
+}
+
+bool AQuoridorBoard::TryPlaceWallAt(int32 StartX, int32 StartY, EWallOrientation Orientation, int32 WallLength)
+{
+    if (WallLength <= 0)
     {
        return false;
     }
@@ -282,7 +520,7 @@ bool AQuoridorBoard::TryPlaceWall(AWallSlot* StartSlot, int32 WallLength)
        return false;
     }
 
-    if (StartSlot->Orientation != PendingWallOrientation)
+    if (Orientation != PendingWallOrientation)
     {
        return false;
     }
@@ -293,152 +531,490 @@ bool AQuoridorBoard::TryPlaceWall(AWallSlot* StartSlot, int32 WallLength)
        return false;
     }
 
-    if (!StartSlot->CanPlaceWall())
-    {
-       return false;
-    }
-
-    // Collect all wall slots that will be affected
-    int32 StartX = StartSlot->GridX;
-    int32 StartY = StartSlot->GridY;
-    EWallOrientation Orientation = StartSlot->Orientation;
-
-    TArray<AWallSlot*> AffectedSlots;
-    AWallSlot* FirstSlot = FindWallSlotAt(StartX, StartY, Orientation);
-    if (!FirstSlot || FirstSlot->bIsOccupied)
+    // Semua segmen harus di dalam grid dan belum ditempati (occupancy dari BoardModel)
+    if (!IsWallSegmentFree(StartX, StartY, Orientation))
     {
        UE_LOG(LogTemp, Warning, TEXT("TryPlaceWall Failed: First slot invalid or occupied"));
        return false;
     }
-    AffectedSlots.Add(FirstSlot);
 
     for (int32 i = 1; i < WallLength; ++i)
     {
        int32 NextX = StartX + (Orientation == EWallOrientation::Horizontal ? i : 0);
        int32 NextY = StartY + (Orientation == EWallOrientation::Vertical ? i : 0);
 
-       if ((Orientation == EWallOrientation::Horizontal && NextX >= GridSize) ||
-          (Orientation == EWallOrientation::Vertical && NextY >= GridSize))
+       if (!IsWallSlotInBounds(NextX, NextY, Orientation))
        {
           UE_LOG(LogTemp, Warning, TEXT("TryPlaceWall Failed: Exceeds bounds"));
           return false;
        }
-      
-       AWallSlot* NextSlot = FindWallSlotAt(NextX, NextY, Orientation);
-       if (!NextSlot || NextSlot->bIsOccupied)
+
+       if (!IsWallSegmentFree(NextX, NextY, Orientation))
        {
           UE_LOG(LogTemp, Warning, TEXT("TryPlaceWall Failed: Next slot invalid or occupied"));
           return false;
        }
-       AffectedSlots.Add(NextSlot);
     }
 
-    // 1. Simulate the wall placement by temporarily marking slots as occupied.
-    for (AWallSlot* Slot : AffectedSlots)
+    // Jalur kedua pemain tetap terbuka? (LegalWallMask, dihitung sekali per giliran)
+    if (!IsLegalWallPlacement(StartX, StartY, Orientation, WallLength))
     {
-        Slot->SetOccupied(true);
+        UE_LOG(LogTemp, Warning, TEXT("TryPlaceWall Failed: Path would be blocked (legal wall mask)"));
+        return false;
     }
 
-    // 2. Create a Minimax state from this simulated board.
-    FMinimaxState SimulatedState = FMinimaxState::FromBoard(this);
+    // Commit: board model, visual, inventory
+    CommitWallPlacement(StartX, StartY, Orientation, WallLength, CurrentPlayerTurn);
 
-    // 3. Check paths for both players using the Minimax engine's pathfinder.
-    int32 PathLen1 = 100; // Default to "no path"
-    int32 PathLen2 = 100;
-    MinimaxEngine::ComputePathToGoal(SimulatedState, 1, &PathLen1);
-    MinimaxEngine::ComputePathToGoal(SimulatedState, 2, &PathLen2);
+    // Cleanup
+    bIsPlacingWall = false;
+    PendingWallLength = 0;
+    SetWallPickingActive(false);
+    HideWallPreview();
 
-    UE_LOG(LogTemp, Log, TEXT("Path check after simulation: Player 1 Length = %d, Player 2 Length = %d"), PathLen1, PathLen2);
+    EndTurn(CurrentPlayerTurn);
 
-    // 4. If either path is blocked (length >= 100 signifies no path), revert the simulation and fail.
-    if (PathLen1 >= 100 || PathLen2 >= 100)
-    {
-        // Revert the temporary change by un-occupying the slots.
-        for (AWallSlot* Slot : AffectedSlots)
-        {
-            Slot->SetOccupied(false);
-        }
-        UE_LOG(LogTemp, Warning, TEXT("TryPlaceWall Failed: Path would be blocked (checked with MinimaxEngine)"));
-        return false;
-    }
+    UE_LOG(LogTemp, Warning, TEXT("TryPlaceWall Success: Wall placed. Turn now: Player %d"), CurrentPlayerTurn);
+    return true;
+}
+
+void AQuoridorBoard::CommitWallPlacement(int32 X, int32 Y, EWallOrientation Orientation, int32 Length, int32 PlayerNumber)
+{
+	const bool bHorizontal = (Orientation == EWallOrientation::Horizontal);
 
-	if (WallClickSound)
+	for (int32 i = 0; i < Length; ++i)
 	{
-		UGameplayStatics::PlaySound2D(this, WallClickSound);
+		if (AWallSlot* Slot = FindWallSlotAt(X + (bHorizontal ? i : 0), Y + (bHorizontal ? 0 : i), Orientation))
+		{
+			Slot->SetOccupied(true);
+		}
 	}
+	ApplyWallToModel(PlayerNumber, X, Y, Length, Orientation);
 
-    // Visual wall placement
-    FVector BaseLocation = StartSlot->GetActorLocation();
-    FRotator WallRotation = Orientation == EWallOrientation::Horizontal ? FRotator::ZeroRotator : FRotator(0, 90, 0);
+	if (bDeferPresentation)
+	{
+		DeferredWallVisuals.Add({ GetWallSlotWorldLocation(X, Y, Orientation), bHorizontal, Length, PlayerNumber });
+	}
+	else
+	{
+		if (WallClickSound)
+		{
+			UGameplayStatics::PlaySound2D(this, WallClickSound);
+		}
 
-    for (int32 i = 0; i < WallLength; ++i)
-    {
-       FVector SegmentLocation = BaseLocation + (Orientation == EWallOrientation::Horizontal
-          ? FVector(i * TileSize, 0, 0)
-          : FVector(0, i * TileSize, 0));
+		SpawnPlacedWallVisuals(GetWallSlotWorldLocation(X, Y, Orientation), bHorizontal, Length, PlayerNumber);
+	}
 
-       AActor* NewWall = GetWorld()->SpawnActor<AActor>(WallPlacementClass, SegmentLocation, WallRotation);
-       if (NewWall)
-       {
-          NewWall->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
-       }
-    }
+	if (AQuoridorPawn* Pawn = GetRegisteredPawn(PlayerNumber))
+	{
+		Pawn->RemoveWallOfLength(Length);
+	}
 
-    if (SelectedPawn)
-    { 
-       SelectedPawn->RemoveWallOfLength(WallLength);
-    }
+	UpdateAllTileConnections();
+}
 
-    // Cleanup
-    bIsPlacingWall = false;
-    PendingWallLength = 0;
-    HideWallPreview();
+//-----------------------------------------------------------------------------
+// Picking analitik
+//-----------------------------------------------------------------------------
+FVector AQuoridorBoard::GetWallSlotWorldLocation(int32 X, int32 Y, EWallOrientation Orientation) const
+{
+	return GetTileWorldLocation(X, Y) + (Orientation == EWallOrientation::Horizontal
+		? FVector(0, TileSize / 2, 0)
+		: FVector(TileSize / 2, 0, 0));
+}
 
-    CurrentPlayerTurn = (CurrentPlayerTurn == 1) ? 2 : 1;
-    TurnCount++;
+bool AQuoridorBoard::PickWallSlotFromWorld(const FVector& WorldLocation, EWallOrientation Orientation, int32& OutX, int32& OutY) const
+{
+	// Koordinat tile kontinu: tile (x, y) berada tepat di (x, y)
+	const FVector Local = WorldLocation - GetActorLocation();
+	const float FX = Local.X / TileSize + GridSize / 2;
+	const float FY = Local.Y / TileSize + GridSize / 2;
 
-    UE_LOG(LogTemp, Warning, TEXT("TryPlaceWall Success: Wall placed. Turn now: Player %d"), CurrentPlayerTurn);
-    return true;
+	if (FX < -0.5f || FY < -0.5f || FX > GridSize - 0.5f || FY > GridSize - 0.5f)
+	{
+		return false;
+	}
+
+	// Horizontal: celah antar baris terdekat (y + 0.5), kolom terdekat; Vertical sebaliknya
+	if (Orientation == EWallOrientation::Horizontal)
+	{
+		OutX = FMath::Clamp(FMath::RoundToInt(FX), 0, GridSize - 1);
+		OutY = FMath::Clamp(FMath::FloorToInt(FY), 0, GridSize - 2);
+	}
+	else
+	{
+		OutX = FMath::Clamp(FMath::FloorToInt(FX), 0, GridSize - 2);
+		OutY = FMath::Clamp(FMath::RoundToInt(FY), 0, GridSize - 1);
+	}
+	return true;
+}
+
+bool AQuoridorBoard::IsWallSlotInBounds(int32 X, int32 Y, EWallOrientation Orientation) const
+{
+	if (Orientation == EWallOrientation::Horizontal)
+	{
+		return X >= 0 && Y >= 0 && X < GridSize && Y < GridSize - 1;
+	}
+	return X >= 0 && Y >= 0 && X < GridSize - 1 && Y < GridSize;
 }
 
+bool AQuoridorBoard::IsWallSegmentFree(int32 X, int32 Y, EWallOrientation Orientation) const
+{
+	if (!IsWallSlotInBounds(X, Y, Orientation))
+	{
+		return false;
+	}
+	return Orientation == EWallOrientation::Horizontal
+		? !BoardModel.HorizontalBlocked[Y][X]
+		: !BoardModel.VerticalBlocked[Y][X];
+}
 
-AWallSlot* AQuoridorBoard::FindWallSlotAt(int32 X, int32 Y, EWallOrientation Orientation) const
+bool AQuoridorBoard::GetCursorBoardLocation(FVector& OutLocation) const
 {
-	// Buat sebuah pointer yang akan menunjuk ke TArray yang benar.
-	// Pointer ini menunjuk ke sebuah TArray konstan.
-	const TArray<AWallSlot*>* pSlotList = nullptr;
+	const APlayerController* PC = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr;
+	FVector RayOrigin, RayDirection;
+	if (!PC || !PC->DeprojectMousePositionToWorld(RayOrigin, RayDirection))
+	{
+		return false;
+	}
 
-	if (Orientation == EWallOrientation::Horizontal)
+	// Potong ray dengan bidang papan (Z = lokasi board)
+	if (FMath::IsNearlyZero(RayDirection.Z))
+	{
+		return false;
+	}
+	const float T = (GetActorLocation().Z - RayOrigin.Z) / RayDirection.Z;
+	if (T < 0.0f)
+	{
+		return false;
+	}
+
+	OutLocation = RayOrigin + RayDirection * T;
+	return true;
+}
+
+void AQuoridorBoard::SetWallPickingActive(bool bActive)
+{
+	HoveredWallSlot = FIntPoint(-1, -1);
+
+	if (WallPickingVolume)
+	{
+		WallPickingVolume->SetCollisionResponseToChannel(ECC_Visibility, bActive ? ECR_Block : ECR_Ignore);
+	}
+
+	if (bActive)
 	{
-		// Arahkan pointer ke HorizontalWallSlots
-		pSlotList = &HorizontalWallSlots;
+		GetWorldTimerManager().SetTimer(WallPickingHoverTimer, this, &AQuoridorBoard::UpdateWallPickingHover, WallPickingHoverInterval, true);
 	}
 	else
 	{
-		// Arahkan pointer ke VerticalWallSlots
-		pSlotList = &VerticalWallSlots;
+		GetWorldTimerManager().ClearTimer(WallPickingHoverTimer);
+	}
+}
+
+void AQuoridorBoard::UpdateWallPickingHover()
+{
+	if (!bIsPlacingWall)
+	{
+		SetWallPickingActive(false);
+		return;
+	}
+
+	FVector CursorLocation;
+	int32 SlotX = -1, SlotY = -1;
+	if (!GetCursorBoardLocation(CursorLocation) || !PickWallSlotFromWorld(CursorLocation, PendingWallOrientation, SlotX, SlotY))
+	{
+		SlotX = SlotY = -1;
 	}
 
-	// Selalu baik untuk memeriksa apakah pointer valid sebelum digunakan
-	if (pSlotList)
+	// Preview hanya di-update saat slot berubah
+	const FIntPoint Picked(SlotX, SlotY);
+	if (Picked == HoveredWallSlot)
 	{
-		// Gunakan operator dereference (*) untuk mengakses isi TArray yang ditunjuk oleh pointer
-		for (AWallSlot* Slot : *pSlotList)
+		return;
+	}
+	HoveredWallSlot = Picked;
+
+	HideWallPreview();
+	if (SlotX >= 0)
+	{
+		ShowWallPreviewAt(SlotX, SlotY, PendingWallOrientation);
+	}
+}
+
+void AQuoridorBoard::OnWallPickingClicked(UPrimitiveComponent* TouchedComponent, FKey ButtonPressed)
+{
+	FVector CursorLocation;
+	if (bIsPlacingWall && GetCursorBoardLocation(CursorLocation))
+	{
+		TryPlaceWallAtWorldLocation(CursorLocation);
+	}
+}
+
+
+AWallSlot* AQuoridorBoard::FindWallSlotAt(int32 X, int32 Y, EWallOrientation Orientation) const
+{
+	// Dipanggil di hot path (UpdateAllTileConnections, TryPlaceWall, AI), jadi tanpa logging
+	if (X < 0 || Y < 0 || X >= GridSize || Y >= GridSize)
+	{
+		return nullptr;
+	}
+
+	const int32 Index = GetWallSlotIndex(X, Y, Orientation);
+	return WallSlotIndex.IsValidIndex(Index) ? WallSlotIndex[Index] : nullptr;
+}
+
+void AQuoridorBoard::BuildWallSlotIndex()
+{
+	WallSlotIndex.Init(nullptr, 2 * GridSize * GridSize);
+
+	for (AWallSlot* Slot : HorizontalWallSlots)
+	{
+		if (Slot && Slot->GridX >= 0 && Slot->GridX < GridSize && Slot->GridY >= 0 && Slot->GridY < GridSize)
 		{
-			if (Slot && Slot->GridX == X && Slot->GridY == Y)
+			WallSlotIndex[GetWallSlotIndex(Slot->GridX, Slot->GridY, EWallOrientation::Horizontal)] = Slot;
+		}
+	}
+
+	for (AWallSlot* Slot : VerticalWallSlots)
+	{
+		if (Slot && Slot->GridX >= 0 && Slot->GridX < GridSize && Slot->GridY >= 0 && Slot->GridY < GridSize)
+		{
+			WallSlotIndex[GetWallSlotIndex(Slot->GridX, Slot->GridY, EWallOrientation::Vertical)] = Slot;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+// Board model (FMinimaxState) - sumber kebenaran untuk engine & validasi
+//-----------------------------------------------------------------------------
+void AQuoridorBoard::ResetBoardModel()
+{
+	BoardModel = FMinimaxState();
+	++BoardModelVersion;
+
+	// Counter proses, bukan per board: engine tahu game berganti walaupun board-nya sama
+	static TAtomic<uint64> NextGameId{ 0 };
+	GameId = ++NextGameId;
+	for (int32 idx = 0; idx < 2; ++idx)
+	{
+		BoardModel.PawnX[idx] = -1;
+		BoardModel.PawnY[idx] = -1;
+		BoardModel.LastPawnPos[idx] = FIntPoint(-1, -1);
+		BoardModel.SecondLastPawnPos[idx] = FIntPoint(-1, -1);
+	}
+}
+
+void AQuoridorBoard::SyncPawnToModel(const AQuoridorPawn* Pawn)
+{
+	if (!Pawn || Pawn->PlayerNumber < 1 || Pawn->PlayerNumber > 2)
+	{
+		return;
+	}
+
+	const int32 idx = Pawn->PlayerNumber - 1;
+	++BoardModelVersion;
+	if (const ATile* Tile = Pawn->GetTile())
+	{
+		BoardModel.PawnX[idx] = Tile->GridX;
+		BoardModel.PawnY[idx] = Tile->GridY;
+		BoardModel.LastPawnPos[idx] = FIntPoint(Tile->GridX, Tile->GridY);
+		BoardModel.SecondLastPawnPos[idx] = BoardModel.LastPawnPos[idx];
+	}
+
+	BoardModel.WallsRemaining[idx] = 0;
+	for (int32 Length = 1; Length <= 3; ++Length)
+	{
+		BoardModel.WallCounts[idx][Length - 1] = Pawn->GetWallCountOfLength(Length);
+		BoardModel.WallsRemaining[idx] += BoardModel.WallCounts[idx][Length - 1];
+	}
+}
+
+void AQuoridorBoard::ApplyPawnMoveToModel(int32 PlayerNumber, int32 X, int32 Y)
+{
+	if (PlayerNumber < 1 || PlayerNumber > 2)
+	{
+		return;
+	}
+	MinimaxEngine::ApplyPawnMove(BoardModel, PlayerNumber, X, Y);
+	++BoardModelVersion;
+}
+
+void AQuoridorBoard::ApplyWallToModel(int32 PlayerNumber, int32 X, int32 Y, int32 Length, EWallOrientation Orientation)
+{
+	if (PlayerNumber < 1 || PlayerNumber > 2)
+	{
+		return;
+	}
+
+	FWallData W;
+	W.X = X;
+	W.Y = Y;
+	W.Length = Length;
+	W.bHorizontal = (Orientation == EWallOrientation::Horizontal);
+	MinimaxEngine::ApplyWall(BoardModel, PlayerNumber, W);
+	++BoardModelVersion;
+}
+
+//-----------------------------------------------------------------------------
+// Cache legal move per giliran. Pawn moves untuk CurrentPlayerTurn, wall mask
+// untuk semua (X, Y, Orientation, Length) sekaligus. Wall yang tidak memotong
+// satu pun edge di jalur terpendek kedua pemain pasti tidak menutup jalur, jadi
+// A* hanya dijalankan untuk kandidat yang memotong jalur tersebut.
+//-----------------------------------------------------------------------------
+void AQuoridorBoard::RefreshLegalMoveCache()
+{
+	if (LegalCacheVersion == BoardModelVersion && LegalCachePlayer == CurrentPlayerTurn)
+	{
+		return;
+	}
+
+	const int32 idx = CurrentPlayerTurn - 1;
+	const bool bPawnOnBoard = (idx == 0 || idx == 1) && BoardModel.PawnX[idx] >= 0 && BoardModel.PawnY[idx] >= 0;
+	LegalPawnMoves = bPawnOnBoard ? MinimaxEngine::GetPawnMoves(BoardModel, CurrentPlayerTurn) : TArray<FIntPoint>();
+
+	if (LegalCacheVersion != BoardModelVersion)
+	{
+		RebuildLegalWallMask();
+	}
+
+	LegalCacheVersion = BoardModelVersion;
+	LegalCachePlayer = CurrentPlayerTurn;
+}
+
+void AQuoridorBoard::RebuildLegalWallMask()
+{
+	FMemory::Memzero(LegalWallMask, sizeof(LegalWallMask));
+	if (GridSize > 9 || BoardModel.PawnX[0] < 0 || BoardModel.PawnX[1] < 0)
+	{
+		return;
+	}
+
+	// Edge yang dipakai jalur terpendek: PathUsesH[y][x] = (x,y)-(x,y+1), PathUsesV[y][x] = (x,y)-(x+1,y)
+	bool PathUsesH[8][9] = {};
+	bool PathUsesV[9][8] = {};
+	auto MarkEdge = [&](FIntPoint A, FIntPoint B)
+	{
+		if (A.X == B.X)      PathUsesH[FMath::Min(A.Y, B.Y)][A.X] = true;
+		else if (A.Y == B.Y) PathUsesV[A.Y][FMath::Min(A.X, B.X)] = true;
+	};
+
+	for (int32 PlayerNum = 1; PlayerNum <= 2; ++PlayerNum)
+	{
+		const TArray<FIntPoint> Path = MinimaxEngine::ComputePathToGoal(BoardModel, PlayerNum);
+		for (int32 i = 1; i < Path.Num(); ++i)
+		{
+			const FIntPoint From = Path[i - 1];
+			const FIntPoint To = Path[i];
+			const FIntPoint D = To - From;
+			if (FMath::Abs(D.X) + FMath::Abs(D.Y) == 1)
+			{
+				MarkEdge(From, To);
+			}
+			else if (D.X == 0 || D.Y == 0)
+			{
+				// Lompat lurus melewati lawan
+				const FIntPoint Mid(From.X + D.X / 2, From.Y + D.Y / 2);
+				MarkEdge(From, Mid);
+				MarkEdge(Mid, To);
+			}
+			else
 			{
-				UE_LOG(LogTemp, Warning, TEXT("FindWallSlotAt => Found Slot at (%d, %d) [%s] => Ptr: %p"),
-					X, Y, *UEnum::GetValueAsString(Orientation), Slot);
-				return Slot;
+				// Side-step diagonal: tandai kedua kemungkinan posisi lawan
+				const FIntPoint MidA(To.X, From.Y);
+				const FIntPoint MidB(From.X, To.Y);
+				MarkEdge(From, MidA);
+				MarkEdge(MidA, To);
+				MarkEdge(From, MidB);
+				MarkEdge(MidB, To);
 			}
 		}
 	}
 
-	UE_LOG(LogTemp, Warning, TEXT("FindWallSlotAt => No slot found at (%d, %d) [%s]"),
-		X, Y, *UEnum::GetValueAsString(Orientation));
-	return nullptr;
+	for (int32 o = 0; o < 2; ++o)
+	{
+		const EWallOrientation Orientation = static_cast<EWallOrientation>(o);
+		const bool bHorizontal = (Orientation == EWallOrientation::Horizontal);
+
+		for (int32 Y = 0; Y < GridSize; ++Y)
+		{
+			for (int32 X = 0; X < GridSize; ++X)
+			{
+				bool bCutsPath = false;
+				for (int32 Length = 1; Length <= 3; ++Length)
+				{
+					// Segmen terakhir dari wall sepanjang Length
+					const int32 SX = X + (bHorizontal ? Length - 1 : 0);
+					const int32 SY = Y + (bHorizontal ? 0 : Length - 1);
+					if (!IsWallSegmentFree(SX, SY, Orientation))
+					{
+						break; // wall yang lebih panjang juga pasti gagal
+					}
+					bCutsPath |= bHorizontal ? PathUsesH[SY][SX] : PathUsesV[SY][SX];
+
+					bool bLegal = !bCutsPath;
+					if (!bLegal)
+					{
+						FMinimaxState Simulated = BoardModel;
+						for (int32 i = 0; i < Length; ++i)
+						{
+							if (bHorizontal) Simulated.HorizontalBlocked[Y][X + i] = true;
+							else             Simulated.VerticalBlocked[Y + i][X] = true;
+						}
+
+						int32 PathLen1 = 100, PathLen2 = 100;
+						MinimaxEngine::ComputePathToGoal(Simulated, 1, &PathLen1);
+						MinimaxEngine::ComputePathToGoal(Simulated, 2, &PathLen2);
+						bLegal = PathLen1 < 100 && PathLen2 < 100;
+					}
+
+					if (bLegal)
+					{
+						LegalWallMask[o][Y][X] |= 1 << (Length - 1);
+					}
+				}
+			}
+		}
+	}
+}
+
+bool AQuoridorBoard::IsLegalPawnMove(int32 PlayerNumber, int32 X, int32 Y)
+{
+	if (PlayerNumber != CurrentPlayerTurn)
+	{
+		// Di luar giliran (jarang): hitung langsung tanpa cache
+		return (PlayerNumber == 1 || PlayerNumber == 2) &&
+			MinimaxEngine::GetPawnMoves(BoardModel, PlayerNumber).Contains(FIntPoint(X, Y));
+	}
+	return GetLegalPawnMoves().Contains(FIntPoint(X, Y));
+}
+
+bool AQuoridorBoard::IsLegalWallPlacement(int32 X, int32 Y, EWallOrientation Orientation, int32 Length)
+{
+	if (Length < 1 || Length > 3 || !IsWallSlotInBounds(X, Y, Orientation))
+	{
+		return false;
+	}
+
+	RefreshLegalMoveCache();
+	return (LegalWallMask[static_cast<int32>(Orientation)][Y][X] & (1 << (Length - 1))) != 0;
 }
 
+const TArray<FIntPoint>& AQuoridorBoard::GetLegalPawnMoves()
+{
+	RefreshLegalMoveCache();
+	return LegalPawnMoves;
+}
+
+void AQuoridorBoard::HighlightLegalMoves()
+{
+	ClearTileHighlights();
+	for (const FIntPoint& Move : GetLegalPawnMoves())
+	{
+		SetTileHighlight(Move.X, Move.Y, ETileHighlight::LegalMove);
+	}
+}
 
 void AQuoridorBoard::StartWallPlacement(int32 WallLength)
 {
@@ -465,6 +1041,7 @@ void AQuoridorBoard::StartWallPlacement(int32 WallLength)
 		}
 
 		// Clear any existing previews
+		SetWallPickingActive(false);
 		HideWallPreview();
 
 		UE_LOG(LogTemp, Warning, TEXT("Wall placement canceled."));
@@ -479,6 +1056,7 @@ void AQuoridorBoard::StartWallPlacement(int32 WallLength)
 
 	// Clear any existing previews when starting placement
 	HideWallPreview();
+	SetWallPickingActive(true);
 
 	UE_LOG(LogTemp, Warning, TEXT("Wall selected: Length = %d, Orientation = %s"),
 		PendingWallLength,
@@ -487,77 +1065,88 @@ void AQuoridorBoard::StartWallPlacement(int32 WallLength)
 
 int32 AQuoridorBoard::GetCurrentPlayerWallCount(int32 WallLength) const
 {
-	for (TActorIterator<AQuoridorPawn> It(GetWorld()); It; ++It)
-	{
-		AQuoridorPawn* Pawn = *It;
-		if (Pawn && Pawn->PlayerNumber == CurrentPlayerTurn)
-		{
-			return Pawn->GetWallCountOfLength(WallLength);
-		}
-	}
-	return 0;
+	return GetWallCountForPlayer(CurrentPlayerTurn, WallLength);
 }
 int32 AQuoridorBoard::GetPlayerTotalWallCount(int32 PlayerNumber) const
 {
-	// Memeriksa jika nomor pemain yang diberikan valid (opsional, tapi praktik yang baik)
-	if (PlayerNumber <= 0)
+	// Mengembalikan 0 jika Pawn dengan PlayerNumber tersebut tidak ditemukan
+	const AQuoridorPawn* Pawn = GetRegisteredPawn(PlayerNumber);
+	return Pawn ? Pawn->GetTotalWallCount() : 0;
+}
+int32 AQuoridorBoard::GetWallCountForPlayer(int32 PlayerNum, int32 WallLength) const
+{
+	const AQuoridorPawn* Pawn = GetRegisteredPawn(PlayerNum);
+	return Pawn ? Pawn->GetWallCountOfLength(WallLength) : 0;
+}
+void AQuoridorBoard::EnsureWallPreviewPool()
+{
+	if (!WallPreviewClass || WallPreviewActors.Num() >= MaxWallPreviewSegments)
 	{
-		return 0; // Nomor pemain tidak valid
+		return;
 	}
 
-	// Melakukan iterasi pada semua AQuoridorPawn di dalam world
-	for (TActorIterator<AQuoridorPawn> It(GetWorld()); It; ++It)
-	{
-		AQuoridorPawn* Pawn = *It;
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 
-		// Memeriksa apakah Pawn valid dan PlayerNumber-nya cocok dengan yang dicari
-		if (Pawn && Pawn->PlayerNumber == PlayerNumber)
+	while (WallPreviewActors.Num() < MaxWallPreviewSegments)
+	{
+		AActor* PreviewSegment = GetWorld()->SpawnActor<AActor>(WallPreviewClass, GetActorLocation(), FRotator::ZeroRotator, SpawnParams);
+		if (!PreviewSegment)
 		{
-			// Jika cocok, kembalikan total jumlah dinding dari Pawn tersebut.
-			// Fungsi ini bergantung pada GetTotalWallCount() di kelas AQuoridorPawn.
-			return Pawn->GetTotalWallCount();
+			break;
 		}
+		PreviewSegment->SetActorHiddenInGame(true);
+		PreviewSegment->SetActorEnableCollision(false);
+		WallPreviewActors.Add(PreviewSegment);
 	}
-
-	// Mengembalikan 0 jika Pawn dengan PlayerNumber tersebut tidak ditemukan
-	return 0;
 }
-int32 AQuoridorBoard::GetWallCountForPlayer(int32 PlayerNum, int32 WallLength) const
+
+void AQuoridorBoard::ShowWallPreviewAtSlot(AWallSlot* HoveredSlot)
 {
-	// Loop melalui semua aktor AQuoridorPawn di dalam world
-	for (TActorIterator<AQuoridorPawn> It(GetWorld()); It; ++It)
+	if (HoveredSlot)
 	{
-		AQuoridorPawn* Pawn = *It;
-
-		// Cek apakah pion ini adalah milik pemain yang kita cari (sesuai parameter)
-		if (Pawn && Pawn->PlayerNumber == PlayerNum) // <-- PERUBAHAN UTAMA DI SINI
-		{
-			// Jika ya, panggil fungsi di pion tersebut dan kembalikan hasilnya
-			return Pawn->GetWallCountOfLength(WallLength);
-		}
+		ShowWallPreviewAt(HoveredSlot->GridX, HoveredSlot->GridY, HoveredSlot->Orientation);
 	}
+}
 
-	// Jika setelah loop selesai pion untuk pemain tersebut tidak ditemukan, kembalikan 0
-	return 0;
+void AQuoridorBoard::ShowWallPreviewAtWorldLocation(const FVector& WorldLocation)
+{
+	int32 SlotX, SlotY;
+	if (PickWallSlotFromWorld(WorldLocation, PendingWallOrientation, SlotX, SlotY))
+	{
+		ShowWallPreviewAt(SlotX, SlotY, PendingWallOrientation);
+	}
 }
-void AQuoridorBoard::ShowWallPreviewAtSlot(AWallSlot* HoveredSlot)
+
+void AQuoridorBoard::ShowWallPreviewAt(int32 X, int32 Y, EWallOrientation Orientation)
 {
-	if (!bIsPlacingWall || !HoveredSlot || !WallPreviewClass) return;
+	if (!bIsPlacingWall || !WallPreviewClass) return;
 
-	if (HoveredSlot->bIsOccupied || HoveredSlot->Orientation != PendingWallOrientation)
+	if (Orientation != PendingWallOrientation || !IsWallSegmentFree(X, Y, Orientation))
 		return;
 
-	// Clear any existing previews
-	HideWallPreview();
+	EnsureWallPreviewPool();
 
 	// Calculate positions for each segment
-	FVector BaseLocation = HoveredSlot->GetActorLocation();
+	FVector BaseLocation = GetWallSlotWorldLocation(X, Y, Orientation);
 	FRotator Rotation = PendingWallOrientation == EWallOrientation::Horizontal
 		? FRotator::ZeroRotator
 		: FRotator(0, 90, 0);
 
-	for (int32 i = 0; i < PendingWallLength; ++i)
+	const int32 SegmentCount = FMath::Min(PendingWallLength, WallPreviewActors.Num());
+	for (int32 i = 0; i < WallPreviewActors.Num(); ++i)
 	{
+		AActor* PreviewSegment = WallPreviewActors[i];
+		if (!PreviewSegment)
+			continue;
+
+		if (i >= SegmentCount)
+		{
+			PreviewSegment->SetActorHiddenInGame(true);
+			PreviewSegment->SetActorEnableCollision(false);
+			continue;
+		}
+
 		FVector SegmentLocation = BaseLocation;
 		if (PendingWallOrientation == EWallOrientation::Horizontal)
 		{
@@ -570,42 +1159,46 @@ void AQuoridorBoard::ShowWallPreviewAtSlot(AWallSlot* HoveredSlot)
 			SegmentLocation.Y += i * TileSize;
 		}
 
-		// Spawn a preview segment
-		AActor* PreviewSegment = GetWorld()->SpawnActor<AActor>(WallPreviewClass, SegmentLocation, Rotation);
-		if (PreviewSegment)
+		// Pindahkan segmen dari pool
+		if (AWallPreview* Preview = Cast<AWallPreview>(PreviewSegment))
 		{
-			if (AWallPreview* Preview = Cast<AWallPreview>(PreviewSegment))
-			{
-				Preview->SetPreviewTransform(SegmentLocation, Rotation, 1, TileSize, PendingWallOrientation);
-			}
-			WallPreviewActors.Add(PreviewSegment);
+			Preview->SetPreviewTransform(SegmentLocation, Rotation, 1, TileSize, PendingWallOrientation);
+		}
+		else
+		{
+			PreviewSegment->SetActorLocationAndRotation(SegmentLocation, Rotation);
 		}
+		PreviewSegment->SetActorHiddenInGame(false);
+		// Tanpa slot lama, klik harus sampai ke WallPickingVolume (preview tidak boleh menghalangi)
+		PreviewSegment->SetActorEnableCollision(bSpawnLegacyWallSlots);
 	}
+	ActiveWallPreviewCount = SegmentCount;
 
-	UE_LOG(LogTemp, Warning, TEXT("Spawned %d preview segments for length %d, Orientation: %s"),
-		WallPreviewActors.Num(), PendingWallLength, PendingWallOrientation == EWallOrientation::Horizontal ? TEXT("Horizontal") : TEXT("Vertical"));
+	UE_LOG(LogTemp, Verbose, TEXT("Showing %d preview segments for length %d, Orientation: %s"),
+		ActiveWallPreviewCount, PendingWallLength, PendingWallOrientation == EWallOrientation::Horizontal ? TEXT("Horizontal") : TEXT("Vertical"));
 }
 
 void AQuoridorBoard::HideWallPreview()
 {
+	if (ActiveWallPreviewCount == 0)
+	{
+		return;
+	}
+
 	for (AActor* Preview : WallPreviewActors)
 	{
 		if (Preview)
 		{
-			Preview->Destroy();
+			Preview->SetActorHiddenInGame(true);
+			Preview->SetActorEnableCollision(false);
 		}
 	}
-	WallPreviewActors.Empty();
+	ActiveWallPreviewCount = 0;
 }
 
 AQuoridorPawn* AQuoridorBoard::GetPawnForPlayer(int32 PlayerNumber)
 {
-	for (TActorIterator<AQuoridorPawn> It(GetWorld()); It; ++It)
-	{
-		if (It->PlayerNumber == PlayerNumber)
-			return *It;
-	}
-	return nullptr;
+	return GetRegisteredPawn(PlayerNumber);
 }
 
 void AQuoridorBoard::ToggleWallOrientation()
@@ -630,6 +1223,9 @@ void AQuoridorBoard::ToggleWallOrientation()
 	// Update player's orientation
 	PlayerOrientations.FindOrAdd(SelectedPawn) = PendingWallOrientation;
 
+	// Slot yang di-hover dihitung ulang untuk orientasi baru
+	HoveredWallSlot = FIntPoint(-1, -1);
+
 	// Log for debugging
 	LogAllPlayerOrientations();
 }
@@ -658,7 +1254,7 @@ EWallOrientation AQuoridorBoard::GetPlayerOrientation(AQuoridorPawn* Pawn) const
 	return EWallOrientation::Horizontal; // default jika belum diset
 }
 
-bool AQuoridorBoard::IsPathAvailableForPawn(AQuoridorPawn* Pawn)
+bool AQuoridorBoard::IsPathAvailableForPawn_Legacy(AQuoridorPawn* Pawn)
 {
     if (!Pawn || !Pawn->CurrentTile)
         return false;
@@ -793,6 +1389,208 @@ bool AQuoridorBoard::IsPathAvailableForPawn(AQuoridorPawn* Pawn)
 
 
 
+//-----------------------------------------------------------------------------
+// Path check (grid): index tile = Y * GridSize + X, neighbour dari cache ConnectedTiles,
+// open set = bucket queue per (F, H) dengan FIFO di tiap bucket. Urutan pemilihan node
+// sama persis dengan versi Legacy (node pertama yang dimasukkan di antara (F, H) minimum).
+//-----------------------------------------------------------------------------
+void AQuoridorBoard::RebuildPathNeighborCache()
+{
+	FMemory::Memzero(PathNeighborCount, sizeof(PathNeighborCount));
+	if (GridSize > PathGridMax)
+	{
+		return;
+	}
+
+	for (int32 Y = 0; Y < GridSize; ++Y)
+	{
+		for (int32 X = 0; X < GridSize; ++X)
+		{
+			const ATile* Tile = Tiles[Y][X];
+			if (!Tile) continue;
+
+			const int32 Index = Y * GridSize + X;
+			for (const ATile* Neighbor : Tile->ConnectedTiles)
+			{
+				if (!Neighbor || PathNeighborCount[Index] >= 4) continue;
+				PathNeighbors[Index][PathNeighborCount[Index]++] = static_cast<uint8>(Neighbor->GridY * GridSize + Neighbor->GridX);
+			}
+		}
+	}
+}
+
+bool AQuoridorBoard::IsPathAvailableForPawn(AQuoridorPawn* Pawn)
+{
+    if (!Pawn || !Pawn->CurrentTile)
+        return false;
+
+    if (GridSize > PathGridMax)
+        return IsPathAvailableForPawn_Legacy(Pawn);
+
+    constexpr int32 MaxTiles   = PathGridMax * PathGridMax;
+    constexpr int32 MaxBuckets = (MaxTiles + PathGridMax) * PathGridMax; // F <= MaxTiles + GridSize, H < GridSize
+
+    const int32 N = GridSize;
+    const int32 TargetRow = (Pawn->PlayerNumber == 1) ? (N - 1) : 0;
+
+    bool  Occupied[MaxTiles];
+    uint8 State[MaxTiles];   // 0 = baru, 1 = open, 2 = closed
+    int32 GCost[MaxTiles];
+    int32 Parent[MaxTiles];
+    int32 NextInBucket[MaxTiles];
+    int32 BucketHead[MaxBuckets];
+    int32 BucketTail[MaxBuckets];
+
+    for (int32 Y = 0; Y < N; ++Y)
+        for (int32 X = 0; X < N; ++X)
+            Occupied[Y * N + X] = Tiles[Y][X] && Tiles[Y][X]->IsOccupied();
+
+    FMemory::Memzero(State, sizeof(State));
+    FMemory::Memset(BucketHead, 0xFF, sizeof(BucketHead));
+    int32 MinKey = MaxBuckets;
+
+    auto Push = [&](int32 Index, int32 G, int32 InParent)
+    {
+        const int32 H   = FMath::Abs(TargetRow - Index / N);
+        const int32 Key = FMath::Min((G + H) * N + H, MaxBuckets - 1);
+        State[Index]  = 1;
+        GCost[Index]  = G;
+        Parent[Index] = InParent;
+        NextInBucket[Index] = INDEX_NONE;
+        if (BucketHead[Key] == INDEX_NONE) BucketHead[Key] = Index;
+        else                               NextInBucket[BucketTail[Key]] = Index;
+        BucketTail[Key] = Index;
+        MinKey = FMath::Min(MinKey, Key);
+    };
+
+    auto IsConnected = [&](int32 From, int32 To)
+    {
+        for (int32 k = 0; k < PathNeighborCount[From]; ++k)
+            if (PathNeighbors[From][k] == To) return true;
+        return false;
+    };
+
+    // Sama dengan GetTileAtWorldPosition: INDEX_NONE jika di luar papan
+    auto TileIndex = [N](int32 X, int32 Y)
+    {
+        return (X >= 0 && X < N && Y >= 0 && Y < N) ? Y * N + X : INDEX_NONE;
+    };
+
+    const int32 StartIndex = Pawn->CurrentTile->GridY * N + Pawn->CurrentTile->GridX;
+    Push(StartIndex, 0, INDEX_NONE);
+
+    int32 Candidates[12];
+    while (MinKey < MaxBuckets)
+    {
+        while (MinKey < MaxBuckets && BucketHead[MinKey] == INDEX_NONE)
+            ++MinKey;
+        if (MinKey >= MaxBuckets)
+            break;
+
+        const int32 Current = BucketHead[MinKey];
+        BucketHead[MinKey] = NextInBucket[Current];
+        State[Current] = 2;
+
+        const int32 CX = Current % N;
+        const int32 CY = Current / N;
+        if (CY == TargetRow)
+        {
+            TArray<FIntPoint> PathTiles;
+            for (int32 Node = Current; Node != INDEX_NONE; Node = Parent[Node])
+            {
+                PathTiles.Add(FIntPoint(Node % N, Node / N));
+            }
+            Algo::Reverse(PathTiles);
+
+            CachedPaths.Add(Pawn->PlayerNumber, PathTiles);
+            return true;
+        }
+
+        int32 NumCandidates = 0;
+        for (int32 k = 0; k < PathNeighborCount[Current]; ++k)
+        {
+            const int32 Neighbor = PathNeighbors[Current][k];
+            if (Occupied[Neighbor])
+            {
+                // Lompat melewati pawn: arah (dx, dy) dari Current ke Neighbor
+                const int32 NX = Neighbor % N, NY = Neighbor / N;
+                const int32 DX = NX - CX, DY = NY - CY;
+
+                const int32 Jump = TileIndex(NX + DX, NY + DY);
+                if (Jump != INDEX_NONE && IsConnected(Neighbor, Jump) && !Occupied[Jump])
+                {
+                    Candidates[NumCandidates++] = Jump;
+                }
+                else
+                {
+                    // Side steps, urutan sama dengan CrossProduct(Dir, Up) lalu kebalikannya
+                    const int32 Side1 = TileIndex(NX + DY, NY - DX);
+                    const int32 Side2 = TileIndex(NX - DY, NY + DX);
+                    if (Side1 != INDEX_NONE && IsConnected(Neighbor, Side1) && !Occupied[Side1])
+                        Candidates[NumCandidates++] = Side1;
+                    if (Side2 != INDEX_NONE && IsConnected(Neighbor, Side2) && !Occupied[Side2])
+                        Candidates[NumCandidates++] = Side2;
+                }
+            }
+            else if (State[Neighbor] != 2)
+            {
+                Candidates[NumCandidates++] = Neighbor;
+            }
+        }
+
+        for (int32 c = 0; c < NumCandidates; ++c)
+        {
+            if (State[Candidates[c]] == 0)
+            {
+                Push(Candidates[c], GCost[Current] + 1, Current);
+            }
+        }
+    }
+
+    CachedPaths.Remove(Pawn->PlayerNumber);
+    return false;
+}
+
+void AQuoridorBoard::Debug_BenchmarkPathSearch(int32 Iterations)
+{
+	Iterations = FMath::Max(1, Iterations);
+
+	for (int32 PlayerNumber = 1; PlayerNumber <= 2; ++PlayerNumber)
+	{
+		AQuoridorPawn* Pawn = GetRegisteredPawn(PlayerNumber);
+		if (!Pawn)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Debug_BenchmarkPathSearch: Player %d pawn missing"), PlayerNumber);
+			continue;
+		}
+
+		double Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			IsPathAvailableForPawn_Legacy(Pawn);
+		}
+		const double LegacySeconds = FPlatformTime::Seconds() - Start;
+		const TArray<FIntPoint> LegacyPath = CachedPaths.FindRef(PlayerNumber);
+
+		Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			IsPathAvailableForPawn(Pawn);
+		}
+		const double GridSeconds = FPlatformTime::Seconds() - Start;
+		const TArray<FIntPoint> GridPath = CachedPaths.FindRef(PlayerNumber);
+
+		UE_LOG(LogTemp, Warning,
+			TEXT("Debug_BenchmarkPathSearch: Player %d | Legacy %.3f us/call | Grid %.3f us/call | x%.1f | Path %s (len %d)"),
+			PlayerNumber,
+			LegacySeconds * 1e6 / Iterations,
+			GridSeconds * 1e6 / Iterations,
+			GridSeconds > 0.0 ? LegacySeconds / GridSeconds : 0.0,
+			LegacyPath == GridPath ? TEXT("identical") : TEXT("MISMATCH"),
+			GridPath.Num());
+	}
+}
+
 ATile* AQuoridorBoard::GetTileAtWorldPosition(const FVector& WorldPosition)
 {
 	for (int32 y = 0; y < GridSize; ++y)
@@ -810,6 +1608,14 @@ ATile* AQuoridorBoard::GetTileAtWorldPosition(const FVector& WorldPosition)
 
 void AQuoridorBoard::UpdateAllTileConnections()
 {
+	// Arah: Atas, Bawah, Kanan, Kiri
+	static const FIntPoint Directions[4] = {
+		{0, 1},   // Atas
+		{0, -1},  // Bawah
+		{1, 0},   // Kanan
+		{-1, 0}   // Kiri
+	};
+
 	for (int32 Y = 0; Y < GridSize; ++Y)
 	{
 		for (int32 X = 0; X < GridSize; ++X)
@@ -819,14 +1625,6 @@ void AQuoridorBoard::UpdateAllTileConnections()
 
 			Tile->ClearConnections();
 
-			// Arah: Atas, Bawah, Kanan, Kiri
-			TArray<FIntPoint> Directions = {
-				{0, 1},   // Atas
-				{0, -1},  // Bawah
-				{1, 0},   // Kanan
-				{-1, 0}   // Kiri
-			};
-
 			for (const FIntPoint& Dir : Directions)
 			{
 				int32 NX = X + Dir.X;
@@ -838,18 +1636,18 @@ void AQuoridorBoard::UpdateAllTileConnections()
 				ATile* Neighbor = Tiles[NY][NX];
 				if (!Neighbor) continue;
 
-				// Cek apakah ada wall yang memisahkan
-				AWallSlot* WallBetween = nullptr;
+				// Cek apakah ada wall yang memisahkan (occupancy dari BoardModel)
+				bool bWallBetween = false;
 				if (Dir.X == 1) // Kanan
-					WallBetween = FindWallSlotAt(X, Y, EWallOrientation::Vertical);
+					bWallBetween = !IsWallSegmentFree(X, Y, EWallOrientation::Vertical);
 				else if (Dir.X == -1) // Kiri
-					WallBetween = FindWallSlotAt(X - 1, Y, EWallOrientation::Vertical);
+					bWallBetween = !IsWallSegmentFree(X - 1, Y, EWallOrientation::Vertical);
 				else if (Dir.Y == 1) // Atas
-					WallBetween = FindWallSlotAt(X, Y, EWallOrientation::Horizontal);
+					bWallBetween = !IsWallSegmentFree(X, Y, EWallOrientation::Horizontal);
 				else if (Dir.Y == -1) // Bawah
-					WallBetween = FindWallSlotAt(X, Y - 1, EWallOrientation::Horizontal);
+					bWallBetween = !IsWallSegmentFree(X, Y - 1, EWallOrientation::Horizontal);
 
-				if (WallBetween && WallBetween->bIsOccupied)
+				if (bWallBetween)
 					continue;
 
 				// Tambahkan koneksi dua arah
@@ -857,6 +1655,8 @@ void AQuoridorBoard::UpdateAllTileConnections()
 			}
 		}
 	}
+
+	RebuildPathNeighborCache();
 }
 
 void AQuoridorBoard::SimulateWallBlock(const TArray<AWallSlot*>& WallSlotsToSimulate, TMap<TPair<ATile*, ATile*>, bool>& OutRemovedConnections)
@@ -907,6 +1707,8 @@ void AQuoridorBoard::SimulateWallBlock(const TArray<AWallSlot*>& WallSlotsToSimu
 			}
 		}
 	}
+
+	RebuildPathNeighborCache();
 }
 
 void AQuoridorBoard::RevertWallBlock(const TMap<TPair<ATile*, ATile*>, bool>& RemovedConnections)
@@ -921,6 +1723,8 @@ void AQuoridorBoard::RevertWallBlock(const TMap<TPair<ATile*, ATile*>, bool>& Re
 			A->AddConnection(B);
 		}
 	}
+
+	RebuildPathNeighborCache();
 }
 
 // Di dalam AQuoridorBoard.cpp
@@ -935,6 +1739,12 @@ void AQuoridorBoard::HandleWin(int32 WinningPlayer)
 	bIsGameFinished = true;
 	
 	WinningTurn = WinningPlayer;
+
+	// Search yang masih jalan tidak relevan lagi
+	if (SearchWorker.IsValid())
+	{
+		SearchWorker->CancelAll();
+	}
 	
     // Pemeriksaan awal untuk memastikan world valid
     if (!IsValid(this) || GetWorld() == nullptr)
@@ -1050,35 +1860,31 @@ void AQuoridorBoard::Debug_PrintOccupiedWalls() const
 {
 	// 1) Horizontal walls
 	UE_LOG(LogTemp, Warning, TEXT("--- Occupied Horizontal Walls ---"));
-	for (AWallSlot* Slot : HorizontalWallSlots)
+	for (int32 slotY = 0; slotY < GridSize - 1; ++slotY)
 	{
-		if (!Slot)
-			continue;
-
-		if (Slot->bIsOccupied)
+		for (int32 slotX = 0; slotX < GridSize; ++slotX)
 		{
-			int slotX = Slot->GridX;  // 0..7
-			int slotY = Slot->GridY;  // 0..8
-			UE_LOG(LogTemp, Warning,
-				TEXT("H‐Wall @ (X=%d, Y=%d)"), 
-				slotX, slotY);
+			if (!IsWallSegmentFree(slotX, slotY, EWallOrientation::Horizontal))
+			{
+				UE_LOG(LogTemp, Warning,
+					TEXT("H‐Wall @ (X=%d, Y=%d)"), 
+					slotX, slotY);
+			}
 		}
 	}
 
 	// 2) Vertical walls
 	UE_LOG(LogTemp, Warning, TEXT("--- Occupied Vertical Walls ---"));
-	for (AWallSlot* Slot : VerticalWallSlots)
+	for (int32 slotY = 0; slotY < GridSize; ++slotY)
 	{
-		if (!Slot)
-			continue;
-
-		if (Slot->bIsOccupied)
+		for (int32 slotX = 0; slotX < GridSize - 1; ++slotX)
 		{
-			int slotX = Slot->GridX;  // 0..8
-			int slotY = Slot->GridY;  // 0..7
-			UE_LOG(LogTemp, Warning,
-				TEXT("V‐Wall @ (X=%d, Y=%d)"), 
-				slotX, slotY);
+			if (!IsWallSegmentFree(slotX, slotY, EWallOrientation::Vertical))
+			{
+				UE_LOG(LogTemp, Warning,
+					TEXT("V‐Wall @ (X=%d, Y=%d)"), 
+					slotX, slotY);
+			}
 		}
 	}
 
@@ -5,11 +5,16 @@
 #include "Quoridor/Tile/Tile.h"
 #include "GameFramework/Actor.h"
 #include "Quoridor/Wall/WallSlot.h"
+#include "Quoridor/Board/MinimaxEngine.h"
 #include "QuoridorBoard.generated.h"
 	
 class ATile;
 class AQuoridorPawn;
 class AWallSlot;
+class UInstancedStaticMeshComponent;
+class UHierarchicalInstancedStaticMeshComponent;
+class UBoxComponent;
+class FMinimaxSearchWorker;
 
 
 UENUM(BlueprintType)
@@ -19,6 +24,20 @@ enum class EPlayerType : uint8
 	AI UMETA(DisplayName = "AI")
 };
 
+/** Nilai PerInstanceCustomData[0] untuk instance tile (dibaca oleh material tile) */
+UENUM(BlueprintType)
+enum class ETileHighlight : uint8
+{
+	None      UMETA(DisplayName = "None"),
+	LegalMove UMETA(DisplayName = "Legal Move"),
+	Hover     UMETA(DisplayName = "Hover"),
+	Selected  UMETA(DisplayName = "Selected")
+};
+
+class AQuoridorBoard;
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBoardReady, AQuoridorBoard*, Board);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnTurnChanged, int32, NewPlayerTurn, int32, NewTurnCount);
+
 UCLASS()
 class QUORIDOR_API AQuoridorBoard : public AActor
 {
@@ -38,6 +57,34 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Settings")
 	bool bAI1IsPlayer1;
+
+	/** Maks thread per search board ini (algoritma paralel); 0 = bagian adil core dibagi board yang sedang mencari */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Settings", meta = (ClampMin = "0"))
+	int32 SearchThreadCap = 0;
+
+	/** Ukuran TT per engine dalam MB; board punya satu engine per pemain, jadi totalnya 2x ini. Dipakai saat engine dibuat */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Settings", meta = (ClampMin = "1"))
+	int32 TranspositionTableSizeMB = MinimaxEngine::DefaultTranspositionTableSizeMB;
+
+	/** MinimaxEngine::bKeepCachesAcrossTurns untuk engine board ini; dipakai saat engine dibuat */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Settings")
+	bool bKeepSearchCachesAcrossTurns = false;
+
+	/** MinimaxEngine::bUseBoardControlTerm (term kontrol papan di Evaluate) untuk engine board ini; dipakai saat engine dibuat */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Settings")
+	bool bUseBoardControlTerm = false;
+
+	/** MinimaxEngine::bEnableSingleSidedSearch untuk engine board ini; dipakai saat engine dibuat */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Settings")
+	bool bEnableSingleSidedSearch = true;
+
+	/** Engine board ini memakai learned evaluator (FMinimaxNNUE) sebagai ganti Evaluate; dipakai saat engine dibuat */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Settings")
+	bool bUseLearnedEvaluator = false;
+
+	/** File bobot QNNU untuk bUseLearnedEvaluator, relatif ke folder project. Gagal dimuat = tetap pakai Evaluate */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Settings", meta = (EditCondition = "bUseLearnedEvaluator"))
+	FString LearnedEvaluatorWeightsPath;
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Audio")
 	USoundBase* PawnMoveSound;
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Audio")
@@ -55,6 +102,18 @@ public:
 	int32 TurnCount = 0;
 	
 	TArray<TArray<ATile*>> Tiles;
+
+	/** Broadcast sekali setelah tile, koneksi dan pion selesai dibuat */
+	UPROPERTY(BlueprintAssignable, Category = "Board")
+	FOnBoardReady OnBoardReady;
+
+	UFUNCTION(BlueprintPure, Category = "Board")
+	bool IsBoardReady() const { return bBoardReady; }
+
+	/** Broadcast setiap giliran berganti (HandleTileClick, TryPlaceWall, ExecuteAction AI); HUD & AI mengikuti event ini */
+	UPROPERTY(BlueprintAssignable, Category = "Quoridor|Game State")
+	FOnTurnChanged OnTurnChanged;
+	FVector GetTileWorldLocation(int32 X, int32 Y) const;
 	UFUNCTION(BlueprintCallable)
 	void Debug_PrintOccupiedWalls() const;
 	
@@ -82,10 +141,29 @@ public:
 	
 	UPROPERTY(VisibleAnywhere)
 	TArray<AWallSlot*> VerticalWallSlots;
+	/** O(1) lookup lewat WallSlotIndex; nullptr jika di luar grid atau slot lama tidak di-spawn */
 	AWallSlot* FindWallSlotAt(int32 X, int32 Y, EWallOrientation Orientation)const;
+
+	/** Posisi dunia slot (X, Y), sama dengan lokasi actor AWallSlot lama */
+	FVector GetWallSlotWorldLocation(int32 X, int32 Y, EWallOrientation Orientation) const;
+
+	/** Titik dunia -> slot terdekat untuk orientasi tersebut; false jika titik di luar papan */
+	bool PickWallSlotFromWorld(const FVector& WorldLocation, EWallOrientation Orientation, int32& OutX, int32& OutY) const;
+
+	/** Slot ada di grid (tanpa melihat occupancy) */
+	bool IsWallSlotInBounds(int32 X, int32 Y, EWallOrientation Orientation) const;
+
+	/** Slot ada di grid dan belum ditempati wall menurut BoardModel */
+	bool IsWallSegmentFree(int32 X, int32 Y, EWallOrientation Orientation) const;
 	
 	UFUNCTION(BlueprintCallable)
 	bool IsPathAvailableForPawn(AQuoridorPawn* Pawn);
+	/** Implementasi lama (FNode + GetTileAtWorldPosition), disimpan sebagai referensi untuk benchmark */
+	bool IsPathAvailableForPawn_Legacy(AQuoridorPawn* Pawn);
+
+	/** Membandingkan IsPathAvailableForPawn dengan versi Legacy (waktu per call + kesamaan CachedPaths) */
+	UFUNCTION(BlueprintCallable, Category = "Debug")
+	void Debug_BenchmarkPathSearch(int32 Iterations = 1000);
 	ATile* GetTileAtWorldPosition(const FVector& WorldPosition);
 
 	UFUNCTION(BlueprintCallable)
@@ -97,19 +175,94 @@ public:
 
 	UFUNCTION(BlueprintCallable)
 	AQuoridorPawn* GetPawnForPlayer(int32 PlayerNumber);
+	AQuoridorPawn* GetRegisteredPawn(int32 PlayerNumber) const
+	{
+		return (PlayerNumber == 1 || PlayerNumber == 2) ? PlayerPawns[PlayerNumber - 1] : nullptr;
+	}
+
+	/** Registry pion per pemain (index PlayerNumber - 1), diisi di SpawnPawn */
+	UPROPERTY(VisibleInstanceOnly, Category = "Pawns")
+	AQuoridorPawn* PlayerPawns[2] = { nullptr, nullptr };
 	TMap<int32, TArray<FIntPoint>> CachedPaths;  // PlayerNumber -> path
 
+	/** Model ringkas papan untuk MinimaxEngine; di-update setiap move/wall sehingga FromBoard cukup menyalin */
+	const FMinimaxState& GetBoardModel() const { return BoardModel; }
+	void SyncPawnToModel(const AQuoridorPawn* Pawn);
+	void ApplyPawnMoveToModel(int32 PlayerNumber, int32 X, int32 Y);
+	void ApplyWallToModel(int32 PlayerNumber, int32 X, int32 Y, int32 Length, EWallOrientation Orientation);
+
+	/** Langkah pion legal; untuk pemain yang sedang giliran dijawab dari cache per giliran */
+	UFUNCTION(BlueprintCallable, Category = "Rules")
+	bool IsLegalPawnMove(int32 PlayerNumber, int32 X, int32 Y);
+
+	/** Wall di dalam grid, tidak menimpa wall lain dan tidak menutup jalur kedua pemain (dari LegalWallMask) */
+	UFUNCTION(BlueprintCallable, Category = "Rules")
+	bool IsLegalWallPlacement(int32 X, int32 Y, EWallOrientation Orientation, int32 Length);
+
+	const TArray<FIntPoint>& GetLegalPawnMoves();
+
+	/** Menandai tujuan legal pion yang sedang giliran (ETileHighlight::LegalMove) */
+	UFUNCTION(BlueprintCallable, Category = "Rendering")
+	void HighlightLegalMoves();
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Antrean search board ini di thread pool bersama (FMinimaxSearchScheduler), dibuat saat pertama dipakai dan dimatikan di EndPlay */
+	TSharedPtr<FMinimaxSearchWorker> SearchWorker;
+	FMinimaxSearchWorker& GetSearchWorker();
+
+	/** Satu engine (TT, history, counter) per pemain, dibuat saat pertama dipakai; hanya dipakai lewat SearchWorker */
+	TSharedPtr<MinimaxEngine> SearchEngines[2];
+	TSharedPtr<MinimaxEngine> GetSearchEngine(int32 PlayerNum);
+
+	FMinimaxState BoardModel;
+	void ResetBoardModel();
+
+	/** Unik per game (diisi ResetBoardModel); engine board ini menyimpan cache search selama GameId sama */
+	uint64 GameId = 0;
+
+	/** Naik setiap BoardModel berubah; cache legal move dibangun ulang jika versi / giliran berbeda */
+	uint32 BoardModelVersion = 0;
+	uint32 LegalCacheVersion = MAX_uint32;
+	int32 LegalCachePlayer = 0;
+	TArray<FIntPoint> LegalPawnMoves;
+	uint8 LegalWallMask[2][9][9] = {}; // [Orientation][Y][X], bit (Length - 1)
+	void RefreshLegalMoveCache();
+	void RebuildLegalWallMask();
+
+	/** Dense index [Orientation][Y][X] -> slot, diisi sekali oleh BuildWallSlotIndex (slot tetap hidup lewat WallSlots) */
+	TArray<AWallSlot*> WallSlotIndex;
+	void BuildWallSlotIndex();
+	int32 GetWallSlotIndex(int32 X, int32 Y, EWallOrientation Orientation) const
+	{
+		return (static_cast<int32>(Orientation) * GridSize + Y) * GridSize + X;
+	}
 
 	void UpdateAllTileConnections();
 
+	/** Neighbour per tile untuk IsPathAvailableForPawn, urutan sama dengan iterasi ConnectedTiles */
+	static constexpr int32 PathGridMax = 9;
+	uint8 PathNeighborCount[PathGridMax * PathGridMax] = {};
+	uint8 PathNeighbors[PathGridMax * PathGridMax][4] = {};
+	void RebuildPathNeighborCache();
+
 	UPROPERTY(EditDefaultsOnly, Category = "Board")
 	TSubclassOf<ATile> TileClass;
 	
 	UPROPERTY(EditDefaultsOnly, Category = "Board")
 	float TileSize = 130.0f;
 
+	/** Jumlah tile yang di-spawn per frame saat konstruksi; <= 0 berarti semua dalam satu frame */
+	UPROPERTY(EditDefaultsOnly, Category = "Board")
+	int32 TileSpawnBudgetPerFrame = 27;
+
+	int32 ConstructionCursor = 0;
+	bool bBoardReady = false;
+	void StepBoardConstruction();
+	void FinishBoardConstruction();
+
 	UPROPERTY(EditDefaultsOnly, Category = "Pawns")
 	TSubclassOf<AQuoridorPawn> PawnClass;
 	
@@ -130,9 +283,73 @@ protected:
 
 	UPROPERTY(EditDefaultsOnly, Category = "Walls")
 	TSubclassOf<AActor> WallPlacementClass;
+
+	//-------------------------------------------------------------------------
+	// Instanced rendering: wall yang sudah dipasang & grid tile digambar lewat
+	// instance milik board. Jika mesh tidak diisi, kembali ke spawn actor lama.
+	//-------------------------------------------------------------------------
+	UPROPERTY(VisibleAnywhere, Category = "Rendering")
+	USceneComponent* BoardRoot;
+
+	UPROPERTY(VisibleAnywhere, Category = "Rendering")
+	UInstancedStaticMeshComponent* WallInstances;
+
+	UPROPERTY(VisibleAnywhere, Category = "Rendering")
+	UHierarchicalInstancedStaticMeshComponent* TileInstances;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Rendering")
+	UStaticMesh* WallSegmentMesh;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Rendering")
+	FVector WallSegmentScale = FVector(1.0f, 1.0f, 1.0f);
+
+	UPROPERTY(EditDefaultsOnly, Category = "Rendering")
+	UStaticMesh* TileInstanceMesh;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Rendering")
+	FVector TileInstanceScale = FVector(1.0f, 1.0f, 1.0f);
+
+	/** Menambah segmen wall visual (instance atau actor WallPlacementClass); CustomData[0] = PlayerNumber */
+	void SpawnPlacedWallVisuals(const FVector& BaseLocation, bool bHorizontal, int32 Length, int32 PlayerNumber);
     
+    /** Wrapper lama untuk Blueprint slot; meneruskan ke TryPlaceWallAt */
     UFUNCTION(BlueprintCallable, Category = "Wall")
     bool TryPlaceWall(AWallSlot* StartSlot, int32 WallLength);
+
+	UFUNCTION(BlueprintCallable, Category = "Wall")
+	bool TryPlaceWallAt(int32 X, int32 Y, EWallOrientation Orientation, int32 WallLength);
+
+	/** Pick slot dari titik dunia dengan PendingWallOrientation / PendingWallLength */
+	UFUNCTION(BlueprintCallable, Category = "Wall")
+	bool TryPlaceWallAtWorldLocation(const FVector& WorldLocation);
+
+	/** Menulis wall yang sudah divalidasi: BoardModel, slot lama, visual, inventory pion, koneksi tile */
+	void CommitWallPlacement(int32 X, int32 Y, EWallOrientation Orientation, int32 Length, int32 PlayerNumber);
+
+	//-------------------------------------------------------------------------
+	// Picking wall analitik: satu box di atas papan menggantikan grid AWallSlot.
+	// Koordinat slot dihitung dari titik cursor pada bidang papan.
+	//-------------------------------------------------------------------------
+	UPROPERTY(VisibleAnywhere, Category = "Walls")
+	UBoxComponent* WallPickingVolume;
+
+	/** Spawn grid AWallSlot lama (untuk Blueprint yang masih memakai klik per slot) */
+	UPROPERTY(EditDefaultsOnly, Category = "Walls")
+	bool bSpawnLegacyWallSlots = false;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Walls")
+	float WallPickingHoverInterval = 1.0f / 30.0f;
+
+	FTimerHandle WallPickingHoverTimer;
+	FIntPoint HoveredWallSlot = FIntPoint(-1, -1);
+
+	/** Aktif selama bIsPlacingWall: volume menerima klik (Visibility) dan preview mengikuti cursor */
+	void SetWallPickingActive(bool bActive);
+	void UpdateWallPickingHover();
+	bool GetCursorBoardLocation(FVector& OutLocation) const;
+
+	UFUNCTION()
+	void OnWallPickingClicked(UPrimitiveComponent* TouchedComponent, FKey ButtonPressed);
 	
 	
 	bool bIsPlacingWall = false;
@@ -149,9 +366,29 @@ protected:
 	UPROPERTY(VisibleAnywhere, Category = "Board")
 	TArray<AActor*> BorderWalls;
 	
+	/** Pool segmen preview (maks. MaxWallPreviewSegments), di-spawn sekali lalu hanya dipindah / di-hide */
+	static constexpr int32 MaxWallPreviewSegments = 3;
 	UPROPERTY(VisibleAnywhere)
-	TArray<AActor*> WallPreviewActors; // New: Store multiple preview actors
-	virtual void Tick(float DeltaTime) override;
+	TArray<AActor*> WallPreviewActors;
+	int32 ActiveWallPreviewCount = 0;
+	void EnsureWallPreviewPool();
+
+	/** Fast-forward: suara dan pesan giliran dilewati, visual wall ditunda sampai FlushDeferredPresentation */
+	bool bDeferPresentation = false;
+	struct FDeferredWallVisual
+	{
+		FVector BaseLocation;
+		bool bHorizontal;
+		int32 Length;
+		int32 PlayerNumber;
+	};
+	TArray<FDeferredWallVisual> DeferredWallVisuals;
+	void SetPresentationDeferred(bool bDefer) { bDeferPresentation = bDefer; }
+	void FlushDeferredPresentation();
+
+	/** Satu-satunya tempat giliran berganti: CurrentPlayerTurn, TurnCount, HUD, lalu OnTurnChanged */
+	void EndTurn(int32 ActingPlayer);
+	void ShowTurnMessage() const;
 	UFUNCTION(BlueprintCallable)
 	EWallOrientation GetPlayerOrientation(AQuoridorPawn* Pawn) const;
 	
@@ -166,9 +403,22 @@ protected:
 	int32 GetWallCountForPlayer(int32 PlayerNum, int32 WallLength) const;
 	UFUNCTION(BlueprintCallable)
 	void HideWallPreview();
+
+	/** Mengubah highlight satu tile (PerInstanceCustomData[0]); no-op jika tile tidak di-instance */
+	UFUNCTION(BlueprintCallable, Category = "Rendering")
+	void SetTileHighlight(int32 X, int32 Y, ETileHighlight Highlight);
+
+	UFUNCTION(BlueprintCallable, Category = "Rendering")
+	void ClearTileHighlights();
 	
 	UFUNCTION(BlueprintCallable)
 	void ShowWallPreviewAtSlot(class AWallSlot* HoveredSlot);
+
+	UFUNCTION(BlueprintCallable)
+	void ShowWallPreviewAt(int32 X, int32 Y, EWallOrientation Orientation);
+
+	UFUNCTION(BlueprintCallable)
+	void ShowWallPreviewAtWorldLocation(const FVector& WorldLocation);
 	void ClearSelection();
 	void SpawnWall(FVector Location, FRotator Rotation, FVector Scale);
 	void SimulateWallBlock(const TArray<AWallSlot*>& WallSlotsToSimulate, TMap<TPair<ATile*, ATile*>, bool>& OutRemovedConnections);
@@ -0,0 +1,366 @@
+﻿// QuoridorSearchBenchCommandlet.cpp
+#include "QuoridorSearchBenchCommandlet.h"
+#include "Quoridor/Board/MinimaxEngine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/Parse.h"
+
+namespace
+{
+    // Corpus bawaan: inventory tetap, langkah dari posisi awal (lihat format di header)
+    const TCHAR* const DefaultCorpus[] =
+    {
+        TEXT("opening_start | 343/433 |"),
+        TEXT("opening_6ply | 343/433 | m41 m47 m42 m46 m43 m45"),
+        TEXT("opening_contact_p2 | 343/433 | m41 m47 m42 m46 m43 m45 m44"),
+        TEXT("midgame_walls_16 | 343/433 | v471 h203 h173 v211 m50 h411 v461 m47 m51 v611 h262 h601 v552 v313 h252 h612 h472 h522 v441 m46"),
+        TEXT("midgame_walls_14 | 343/433 | v353 h401 v462 m47 v553 h301 h173 v402 h342 h112 v441 m46 m30 h411 h572 m45 h532 m55 m20 v101 m21 m54"),
+        TEXT("endgame_single_sided | 343/433 | m41 h213 m51 h501 h471 v512 m52 h521 h271 v402 h562 h432 v571 v613 v662 v331 m42 v223 h452 h121 m32 m38 m33 m37 m34 m36"),
+        TEXT("endgame_race | 343/433 | v361 h501 m41 v403 h473 h201 v271 v313 h261 v203 h352 v501 v252 h332 h513 v431 v452 v162 m40 m38 h022 v702 h553 m28 m30 m18 m31 m17 m32 m16"),
+    };
+
+    struct FBenchPosition
+    {
+        FString Name;
+        FMinimaxState State;
+        int32 SideToMove = 1;
+    };
+
+    struct FBenchRow
+    {
+        int32 Depth = 0;
+        FString BestMove;
+        int32 Score = 0;
+        int64 Nodes = 0;
+        int64 TTHits = 0;
+        int64 TTCutoffs = 0;
+        double Seconds = 0.0;   // Tercepat dari semua repeat
+    };
+
+    FString FormatAction(const FMinimaxAction& Act)
+    {
+        if (Act.bIsWall)
+            return FString::Printf(TEXT("%c%d%d%d"), Act.bHorizontal ? TEXT('h') : TEXT('v'), Act.SlotX, Act.SlotY, Act.WallLength);
+        if (Act.MoveX < 0 || Act.MoveY < 0)
+            return TEXT("none");
+        return FString::Printf(TEXT("m%d%d"), Act.MoveX, Act.MoveY);
+    }
+
+    bool ParseAction(const FString& Token, FMinimaxAction& OutAction)
+    {
+        const bool bWall = Token.StartsWith(TEXT("h")) || Token.StartsWith(TEXT("v"));
+        if (Token.Len() != (bWall ? 4 : 3) || (!bWall && !Token.StartsWith(TEXT("m"))))
+            return false;
+
+        int32 Digits[3] = { 0, 0, 0 };
+        for (int32 i = 1; i < Token.Len(); ++i)
+        {
+            if (!FChar::IsDigit(Token[i]))
+                return false;
+            Digits[i - 1] = Token[i] - TEXT('0');
+        }
+
+        if (!bWall)
+        {
+            OutAction = FMinimaxAction(Digits[0], Digits[1]);
+            return true;
+        }
+        if (Digits[2] < 1 || Digits[2] > 3)
+            return false;
+        OutAction = FMinimaxAction(Digits[0], Digits[1], Digits[2], Token.StartsWith(TEXT("h")));
+        return true;
+    }
+
+    bool ParsePosition(const FString& Line, FBenchPosition& OutPosition, FString& OutError)
+    {
+        TArray<FString> Parts;
+        Line.ParseIntoArray(Parts, TEXT("|"), false);
+        if (Parts.Num() != 3)
+        {
+            OutError = TEXT("butuh 3 kolom: nama | inventory | langkah");
+            return false;
+        }
+        for (FString& Part : Parts)
+        {
+            Part.TrimStartAndEndInline();
+        }
+        OutPosition.Name = Parts[0];
+
+        TArray<FString> Inventory;
+        Parts[1].ParseIntoArray(Inventory, TEXT("/"));
+        if (OutPosition.Name.IsEmpty() || Inventory.Num() != 2 || Inventory[0].Len() != 3 || Inventory[1].Len() != 3)
+        {
+            OutError = TEXT("nama kosong atau inventory bukan format 343/433");
+            return false;
+        }
+
+        FMinimaxState& S = OutPosition.State;
+        FMemory::Memzero(&S, sizeof(S));
+        const FIntPoint StartPos[2] = { FIntPoint(4, 0), FIntPoint(4, 8) };
+        for (int32 idx = 0; idx < 2; ++idx)
+        {
+            S.PawnX[idx] = StartPos[idx].X;
+            S.PawnY[idx] = StartPos[idx].Y;
+            S.LastPawnPos[idx] = StartPos[idx];
+            S.SecondLastPawnPos[idx] = StartPos[idx];
+            for (int32 Length = 0; Length < 3; ++Length)
+            {
+                const TCHAR Count = Inventory[idx][Length];
+                if (!FChar::IsDigit(Count))
+                {
+                    OutError = FString::Printf(TEXT("inventory '%s' bukan angka"), *Inventory[idx]);
+                    return false;
+                }
+                S.WallCounts[idx][Length] = Count - TEXT('0');
+                S.WallsRemaining[idx] += S.WallCounts[idx][Length];
+            }
+        }
+        S.Accumulator.bValid = false;
+
+        TArray<FString> Tokens;
+        Parts[2].ParseIntoArrayWS(Tokens);
+        int32 Player = 1;
+        for (int32 i = 0; i < Tokens.Num(); ++i)
+        {
+            FMinimaxAction Act;
+            if (!ParseAction(Tokens[i], Act) || !MinimaxEngine::IsActionLegal(S, Player, Act))
+            {
+                OutError = FString::Printf(TEXT("langkah %d '%s' tidak valid untuk Player %d"), i + 1, *Tokens[i], Player);
+                return false;
+            }
+
+            if (Act.bIsWall)
+            {
+                MinimaxEngine::ApplyWall(S, Player, FWallData{ Act.SlotX, Act.SlotY, Act.WallLength, Act.bHorizontal });
+            }
+            else
+            {
+                MinimaxEngine::ApplyPawnMove(S, Player, Act.MoveX, Act.MoveY);
+                if (S.PawnY[Player - 1] == ((Player == 1) ? 8 : 0))
+                {
+                    OutError = FString::Printf(TEXT("Player %d sudah sampai goal di langkah %d"), Player, i + 1);
+                    return false;
+                }
+            }
+            Player = 3 - Player;
+        }
+        OutPosition.SideToMove = Player;
+        return true;
+    }
+}
+
+UQuoridorSearchBenchCommandlet::UQuoridorSearchBenchCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UQuoridorSearchBenchCommandlet::Main(const FString& Params)
+{
+    FString AlgosParam = TEXT("1,2,3,4");
+    int32 MaxDepth = 3;
+    int32 Repeat = 1;
+    int32 SearchThreads = 1;  // default deterministik; >1 (atau 0 = tanpa batas) harus diminta eksplisit
+    int32 TTSizeMB = 4;
+    FString CorpusPath;
+    FString WeightsPath;
+    FString OutPath = FPaths::ProjectSavedDir() / TEXT("SearchBench") /
+        FString::Printf(TEXT("SearchBench_%s.csv"), *FDateTime::Now().ToString());
+
+    FParse::Value(*Params, TEXT("Algos="), AlgosParam);
+    FParse::Value(*Params, TEXT("MaxDepth="), MaxDepth);
+    FParse::Value(*Params, TEXT("Repeat="), Repeat);
+    FParse::Value(*Params, TEXT("SearchThreads="), SearchThreads);
+    FParse::Value(*Params, TEXT("TTMB="), TTSizeMB);
+    FParse::Value(*Params, TEXT("Corpus="), CorpusPath);
+    FParse::Value(*Params, TEXT("Weights="), WeightsPath);
+    FParse::Value(*Params, TEXT("Out="), OutPath);
+
+    TArray<int32> Algorithms;
+    {
+        TArray<FString> AlgoTokens;
+        AlgosParam.ParseIntoArray(AlgoTokens, TEXT(","));
+        for (const FString& Token : AlgoTokens)
+        {
+            const int32 Algorithm = FCString::Atoi(*Token);
+            if (Algorithm < 1 || Algorithm > 4)
+            {
+                UE_LOG(LogTemp, Error, TEXT("QuoridorSearchBench: Algoritma tidak valid '%s' (1-4)"), *Token);
+                return 1;
+            }
+            Algorithms.AddUnique(Algorithm);
+        }
+    }
+    if (Algorithms.Num() == 0 || MaxDepth < 1 || Repeat < 1)
+    {
+        UE_LOG(LogTemp, Error, TEXT("QuoridorSearchBench: Algos tidak boleh kosong, MaxDepth dan Repeat harus > 0"));
+        return 1;
+    }
+
+    // Corpus
+    TArray<FString> Lines;
+    if (CorpusPath.IsEmpty())
+    {
+        for (const TCHAR* Line : DefaultCorpus)
+        {
+            Lines.Add(Line);
+        }
+    }
+    else
+    {
+        if (FPaths::IsRelative(CorpusPath))
+        {
+            CorpusPath = FPaths::ProjectDir() / CorpusPath;
+        }
+        if (!FFileHelper::LoadFileToStringArray(Lines, *CorpusPath))
+        {
+            UE_LOG(LogTemp, Error, TEXT("QuoridorSearchBench: Gagal membaca corpus %s"), *CorpusPath);
+            return 1;
+        }
+    }
+
+    TArray<FBenchPosition> Positions;
+    for (int32 LineIndex = 0; LineIndex < Lines.Num(); ++LineIndex)
+    {
+        const FString Line = Lines[LineIndex].TrimStartAndEnd();
+        if (Line.IsEmpty() || Line.StartsWith(TEXT("#")))
+            continue;
+
+        FBenchPosition Position;
+        FString Error;
+        if (!ParsePosition(Line, Position, Error))
+        {
+            UE_LOG(LogTemp, Error, TEXT("QuoridorSearchBench: Corpus baris %d: %s"), LineIndex + 1, *Error);
+            return 1;
+        }
+        Positions.Add(Position);
+    }
+    if (Positions.Num() == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("QuoridorSearchBench: Corpus kosong"));
+        return 1;
+    }
+
+    if (FPaths::IsRelative(OutPath))
+    {
+        OutPath = FPaths::ProjectDir() / OutPath;
+    }
+
+    // -Weights: semua search memakai learned evaluator (satu network dibagi semua engine)
+    TSharedPtr<const FMinimaxNNUE> Network;
+    if (!WeightsPath.IsEmpty())
+    {
+        TSharedPtr<FMinimaxNNUE> Loaded = MakeShared<FMinimaxNNUE>();
+        if (!Loaded->LoadFromFile(FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), WeightsPath)))
+        {
+            UE_LOG(LogTemp, Error, TEXT("QuoridorSearchBench: Gagal memuat weights %s"), *WeightsPath);
+            return 1;
+        }
+        Network = Loaded;
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("QuoridorSearchBench: %d posisi, Algos=%s, MaxDepth=%d, Repeat=%d, SearchThreads=%d"),
+        Positions.Num(), *AlgosParam, MaxDepth, Repeat, SearchThreads);
+
+    FString Csv = TEXT("position,side_to_move,algorithm,depth,best_move,score,nodes,cumulative_nodes,tt_hits,tt_cutoffs,seconds,time_to_depth,nodes_per_second\n");
+    TMap<int32, int64> TotalNodes;
+    TMap<int32, double> TotalSeconds;
+    int32 NondeterministicRuns = 0;
+
+    for (const FBenchPosition& Position : Positions)
+    {
+        for (const int32 Algorithm : Algorithms)
+        {
+            TArray<FBenchRow> Rows;
+            Rows.SetNum(MaxDepth);
+            bool bNodesDiffer = false;
+
+            for (int32 Run = 0; Run < Repeat; ++Run)
+            {
+                // Engine baru per repeat: depth 1..MaxDepth berbagi TT / history seperti iterative deepening di game
+                MinimaxEngine Engine(TTSizeMB);
+                Engine.MaxSearchThreads = SearchThreads;
+                Engine.LearnedEvaluator = Network;
+                Engine.bUseLearnedEvaluator = Network.IsValid();
+
+                for (int32 d = 1; d <= MaxDepth; ++d)
+                {
+                    Engine.ResetStats();
+                    const double Start = FPlatformTime::Seconds();
+                    const FMinimaxResult Result = Engine.RunSelectedAlgorithm(Position.State, d, Position.SideToMove, Algorithm);
+                    const double Elapsed = FPlatformTime::Seconds() - Start;
+                    const FMinimaxSearchStats Stats = Engine.GetStats();
+
+                    FBenchRow& Row = Rows[d - 1];
+                    if (Run == 0)
+                    {
+                        Row.Depth = d;
+                        Row.BestMove = FormatAction(Result.BestAction);
+                        Row.Score = Result.BestValue;
+                        Row.Nodes = Stats.NodesSearched;
+                        Row.TTHits = Stats.TTHits;
+                        Row.TTCutoffs = Stats.TTCutoffs;
+                        Row.Seconds = Elapsed;
+                    }
+                    else
+                    {
+                        bNodesDiffer |= (Row.Nodes != Stats.NodesSearched);
+                        Row.Seconds = FMath::Min(Row.Seconds, Elapsed);
+                    }
+                }
+            }
+
+            if (bNodesDiffer)
+            {
+                ++NondeterministicRuns;
+                UE_LOG(LogTemp, Warning, TEXT("QuoridorSearchBench: %s algo %d: node count berbeda antar repeat (search paralel)"),
+                    *Position.Name, Algorithm);
+            }
+
+            int64 CumulativeNodes = 0;
+            double TimeToDepth = 0.0;
+            for (const FBenchRow& Row : Rows)
+            {
+                CumulativeNodes += Row.Nodes;
+                TimeToDepth += Row.Seconds;
+                Csv += FString::Printf(TEXT("%s,%d,%d,%d,%s,%d,%lld,%lld,%lld,%lld,%.6f,%.6f,%.0f\n"),
+                    *Position.Name, Position.SideToMove, Algorithm, Row.Depth, *Row.BestMove, Row.Score,
+                    Row.Nodes, CumulativeNodes, Row.TTHits, Row.TTCutoffs, Row.Seconds, TimeToDepth,
+                    Row.Seconds > 0.0 ? Row.Nodes / Row.Seconds : 0.0);
+            }
+            TotalNodes.FindOrAdd(Algorithm) += CumulativeNodes;
+            TotalSeconds.FindOrAdd(Algorithm) += TimeToDepth;
+
+            UE_LOG(LogTemp, Display, TEXT("QuoridorSearchBench: %s algo %d depth %d: %s, %lld node, %.3f s"),
+                *Position.Name, Algorithm, MaxDepth, *Rows.Last().BestMove, CumulativeNodes, TimeToDepth);
+        }
+    }
+
+    // Agregat per algoritma
+    FString Summary = TEXT("{\n");
+    Summary += FString::Printf(TEXT("  \"weights\": \"%s\",\n"), *WeightsPath.Replace(TEXT("\\"), TEXT("/")));
+    Summary += FString::Printf(TEXT("  \"positions\": %d,\n  \"max_depth\": %d,\n  \"repeat\": %d,\n  \"search_threads\": %d,\n  \"tt_mb\": %d,\n  \"nondeterministic_runs\": %d,\n  \"algorithms\": {\n"),
+        Positions.Num(), MaxDepth, Repeat, SearchThreads, TTSizeMB, NondeterministicRuns);
+    for (int32 i = 0; i < Algorithms.Num(); ++i)
+    {
+        const int32 Algorithm = Algorithms[i];
+        const int64 Nodes = TotalNodes.FindRef(Algorithm);
+        const double Seconds = TotalSeconds.FindRef(Algorithm);
+        Summary += FString::Printf(TEXT("    \"%d\": { \"nodes\": %lld, \"seconds\": %.6f, \"nodes_per_second\": %.0f }%s\n"),
+            Algorithm, Nodes, Seconds, Seconds > 0.0 ? Nodes / Seconds : 0.0,
+            i + 1 < Algorithms.Num() ? TEXT(",") : TEXT(""));
+    }
+    Summary += TEXT("  }\n}\n");
+
+    const FString SummaryPath = FPaths::ChangeExtension(OutPath, TEXT("summary.json"));
+    if (!FFileHelper::SaveStringToFile(Csv, *OutPath) || !FFileHelper::SaveStringToFile(Summary, *SummaryPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("QuoridorSearchBench: Gagal menulis %s / %s"), *OutPath, *SummaryPath);
+        return 1;
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("QuoridorSearchBench: Selesai. Results: %s"), *OutPath);
+    return 0;
+}
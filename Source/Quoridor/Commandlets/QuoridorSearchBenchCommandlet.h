@@ -0,0 +1,42 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "QuoridorSearchBenchCommandlet.generated.h"
+
+/**
+ * Benchmark search engine pada corpus posisi tetap (opening, midgame dengan banyak wall, endgame).
+ *
+ *   UnrealEditor-Cmd Quoridor.uproject -run=QuoridorSearchBench -nullrhi -unattended
+ *       -Algos=1,2,3,4 -MaxDepth=3 -Repeat=3 -TTMB=4
+ *       -Corpus=Bench/positions.txt -Out=Saved/SearchBench/build_a.csv [-Weights=Bench/net.qnnu]
+ *
+ * Untuk setiap posisi dan algoritma, satu MinimaxEngine baru mencari depth 1..MaxDepth berurutan
+ * (seperti iterative deepening) dan setiap depth ditulis satu baris CSV: best move, skor, node,
+ * detik, time-to-depth kumulatif dan node/detik. Urutan baris dan kolom tetap, jadi dua file dari
+ * build berbeda bisa langsung di-diff: best_move / score / nodes harus sama kecuali engine-nya
+ * memang berubah, kolom waktu yang berubah menunjukkan performa. -Repeat mengambil waktu tercepat.
+ * Default -SearchThreads=1. Algoritma 2 dan 4 membagi TT dan history antar lane ParallelFor, jadi
+ * dengan -SearchThreads>1 (atau 0 = tanpa batas) node count dan best move bergantung pada timing
+ * thread dan file tidak bisa di-diff eksak. Total per algoritma ditulis ke <Out>.summary.json.
+ * -Weights: semua search memakai learned evaluator dari file itu, untuk dibandingkan dengan run tanpa -Weights.
+ *
+ * Corpus bawaan dipakai jika -Corpus tidak diberikan. Format file sama dengan corpus bawaan, satu
+ * posisi per baris (baris kosong dan '#' diabaikan):
+ *
+ *   nama | inventory P1/P2 (jumlah wall panjang 1,2,3) | langkah dari posisi awal
+ *   midgame_walls | 343/433 | m41 h203 v552 ...
+ *
+ * Langkah: mXY = pion ke (X,Y); hXYL / vXYL = wall horizontal / vertikal di slot (X,Y) panjang L.
+ * Player 1 jalan pertama; setiap langkah divalidasi dengan MinimaxEngine::IsActionLegal.
+ */
+UCLASS()
+class QUORIDOR_API UQuoridorSearchBenchCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UQuoridorSearchBenchCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
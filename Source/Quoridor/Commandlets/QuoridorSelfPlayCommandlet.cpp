@@ -0,0 +1,322 @@
+﻿// QuoridorSelfPlayCommandlet.cpp
+#include "QuoridorSelfPlayCommandlet.h"
+#include "Quoridor/Board/MinimaxEngine.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformMisc.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/Parse.h"
+
+namespace
+{
+    struct FSelfPlayConfig
+    {
+        int32 Algorithm = 3;
+        int32 Depth = 3;
+        bool bLearnedEvaluator = false; // butuh -Weights
+        bool bBoardControl = false;     // MinimaxEngine::bUseBoardControlTerm
+        bool bSingleSided = true;       // MinimaxEngine::bEnableSingleSidedSearch
+    };
+
+    struct FSelfPlayGame
+    {
+        int32 GameIndex = 0;
+        int32 Seed = 0;
+        int32 PlayerOfA = 1;   // 1 atau 2
+        int32 Winner = 0;      // 0 = seri (MaxPlies habis)
+        int32 Plies = 0;
+        int32 WallCounts[2][3] = {};
+        double ThinkTime[2] = { 0.0, 0.0 };      // [0] = konfigurasi A, [1] = B
+        TArray<double> MoveTimes[2];
+        FString EndReason;
+    };
+
+    FMinimaxState MakeInitialState(FRandomStream& Random, int32 OutWallCounts[2][3])
+    {
+        FMinimaxState S;
+        FMemory::Memzero(&S, sizeof(S));
+
+        const FIntPoint StartPos[2] = { FIntPoint(4, 0), FIntPoint(4, 8) };
+        for (int32 idx = 0; idx < 2; ++idx)
+        {
+            S.PawnX[idx] = StartPos[idx].X;
+            S.PawnY[idx] = StartPos[idx].Y;
+            S.LastPawnPos[idx] = StartPos[idx];
+            S.SecondLastPawnPos[idx] = StartPos[idx];
+
+            // Sama dengan SpawnPawn: 10 wall dengan panjang acak 1-3
+            for (int32 i = 0; i < 10; ++i)
+            {
+                S.WallCounts[idx][Random.RandRange(1, 3) - 1]++;
+            }
+            S.WallsRemaining[idx] = 10;
+            for (int32 Length = 0; Length < 3; ++Length)
+            {
+                OutWallCounts[idx][Length] = S.WallCounts[idx][Length];
+            }
+        }
+        S.Accumulator.bValid = false;
+        return S;
+    }
+
+    void ConfigureEngine(MinimaxEngine& Engine, const FSelfPlayConfig& Config, const TSharedPtr<const FMinimaxNNUE>& Network, int32 SearchThreads)
+    {
+        Engine.MaxSearchThreads = SearchThreads;
+        Engine.bUseLearnedEvaluator = Config.bLearnedEvaluator;
+        Engine.bUseBoardControlTerm = Config.bBoardControl;
+        Engine.bEnableSingleSidedSearch = Config.bSingleSided;
+        Engine.LearnedEvaluator = Network;
+    }
+
+    void PlaySelfPlayGame(FSelfPlayGame& Game, const FSelfPlayConfig Configs[2], int32 MaxPlies, int32 TTSizeMB,
+                          const TSharedPtr<const FMinimaxNNUE>& Network, int32 SearchThreads)
+    {
+        FRandomStream Random(Game.Seed);
+        FMinimaxState S = MakeInitialState(Random, Game.WallCounts);
+
+        // Engine sendiri per konfigurasi per game: tidak ada state yang dibagi antar game yang jalan bersamaan
+        MinimaxEngine EngineA(TTSizeMB);
+        MinimaxEngine EngineB(TTSizeMB);
+        MinimaxEngine* Engines[2] = { &EngineA, &EngineB };
+        ConfigureEngine(EngineA, Configs[0], Network, SearchThreads);
+        ConfigureEngine(EngineB, Configs[1], Network, SearchThreads);
+
+        int32 Player = 1;
+        for (Game.Plies = 0; Game.Plies < MaxPlies; )
+        {
+            const int32 Side = (Player == Game.PlayerOfA) ? 0 : 1;
+            const FSelfPlayConfig& Config = Configs[Side];
+
+            // Sama dengan board: cache per giliran mengikuti bKeepCachesAcrossTurns
+            Engines[Side]->BeginTurn(Game.Plies);
+            const double Start = FPlatformTime::Seconds();
+            const FMinimaxResult Result = Engines[Side]->RunSelectedAlgorithm(S, Config.Depth, Player, Config.Algorithm);
+            const double Elapsed = FPlatformTime::Seconds() - Start;
+            Game.ThinkTime[Side] += Elapsed;
+            Game.MoveTimes[Side].Add(Elapsed);
+            ++Game.Plies;
+
+            // Inventory, overlap / crossing dan wall yang menutup path semuanya dihitung kalah
+            const FMinimaxAction& Act = Result.BestAction;
+            if (!MinimaxEngine::IsActionLegal(S, Player, Act))
+            {
+                Game.Winner = 3 - Player;
+                Game.EndReason = Act.bIsWall ? TEXT("illegal_wall") : TEXT("illegal_move");
+                return;
+            }
+
+            if (Act.bIsWall)
+            {
+                FWallData W{ Act.SlotX, Act.SlotY, Act.WallLength, Act.bHorizontal };
+                MinimaxEngine::ApplyWall(S, Player, W);
+            }
+            else
+            {
+                MinimaxEngine::ApplyPawnMove(S, Player, Act.MoveX, Act.MoveY);
+            }
+
+            const int32 GoalY = (Player == 1) ? 8 : 0;
+            if (S.PawnY[Player - 1] == GoalY)
+            {
+                Game.Winner = Player;
+                Game.EndReason = TEXT("goal");
+                return;
+            }
+
+            Player = 3 - Player;
+        }
+
+        Game.Winner = 0;
+        Game.EndReason = TEXT("max_plies");
+    }
+
+    double Percentile(TArray<double> Values, double Fraction)
+    {
+        if (Values.Num() == 0)
+            return 0.0;
+
+        Values.Sort();
+        const int32 Index = FMath::Clamp(FMath::FloorToInt(Fraction * (Values.Num() - 1) + 0.5), 0, Values.Num() - 1);
+        return Values[Index];
+    }
+}
+
+UQuoridorSelfPlayCommandlet::UQuoridorSelfPlayCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UQuoridorSelfPlayCommandlet::Main(const FString& Params)
+{
+    int32 NumGames = 100;
+    int32 Seed = 12345;
+    int32 MaxPlies = 200;
+    int32 Concurrency = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+    int32 TTSizeMB = 4;
+    int32 SearchThreads = 0;  // 0 = bagian adil core per lane, dihitung setelah Concurrency
+    FSelfPlayConfig Configs[2];
+    FString WeightsPath;
+    FString OutPath = FPaths::ProjectSavedDir() / TEXT("SelfPlay") /
+        FString::Printf(TEXT("SelfPlay_%s.csv"), *FDateTime::Now().ToString());
+
+    FParse::Value(*Params, TEXT("Games="), NumGames);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    FParse::Value(*Params, TEXT("MaxPlies="), MaxPlies);
+    FParse::Value(*Params, TEXT("Concurrency="), Concurrency);
+    FParse::Value(*Params, TEXT("TTMB="), TTSizeMB);
+    FParse::Value(*Params, TEXT("SearchThreads="), SearchThreads);
+    FParse::Value(*Params, TEXT("AlgoA="), Configs[0].Algorithm);
+    FParse::Value(*Params, TEXT("DepthA="), Configs[0].Depth);
+    FParse::Value(*Params, TEXT("AlgoB="), Configs[1].Algorithm);
+    FParse::Value(*Params, TEXT("DepthB="), Configs[1].Depth);
+    FParse::Bool(*Params, TEXT("LearnedA="), Configs[0].bLearnedEvaluator);
+    FParse::Bool(*Params, TEXT("LearnedB="), Configs[1].bLearnedEvaluator);
+    FParse::Bool(*Params, TEXT("BoardControlA="), Configs[0].bBoardControl);
+    FParse::Bool(*Params, TEXT("BoardControlB="), Configs[1].bBoardControl);
+    FParse::Bool(*Params, TEXT("SingleSidedA="), Configs[0].bSingleSided);
+    FParse::Bool(*Params, TEXT("SingleSidedB="), Configs[1].bSingleSided);
+    FParse::Value(*Params, TEXT("Weights="), WeightsPath);
+    FParse::Value(*Params, TEXT("Out="), OutPath);
+
+    if (NumGames <= 0 || MaxPlies <= 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("QuoridorSelfPlay: Games dan MaxPlies harus > 0"));
+        return 1;
+    }
+    for (const FSelfPlayConfig& Config : Configs)
+    {
+        if (Config.Algorithm < 1 || Config.Algorithm > 4 || Config.Depth < 1)
+        {
+            UE_LOG(LogTemp, Error, TEXT("QuoridorSelfPlay: Konfigurasi tidak valid (Algo=%d Depth=%d)"), Config.Algorithm, Config.Depth);
+            return 1;
+        }
+    }
+    if (FPaths::IsRelative(OutPath))
+    {
+        OutPath = FPaths::ProjectDir() / OutPath;
+    }
+
+    // Satu network untuk semua game; read-only saat search jadi aman dibagi antar lane
+    TSharedPtr<const FMinimaxNNUE> Network;
+    if (Configs[0].bLearnedEvaluator || Configs[1].bLearnedEvaluator)
+    {
+        TSharedPtr<FMinimaxNNUE> Loaded = MakeShared<FMinimaxNNUE>();
+        if (WeightsPath.IsEmpty() || !Loaded->LoadFromFile(FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), WeightsPath)))
+        {
+            UE_LOG(LogTemp, Error, TEXT("QuoridorSelfPlay: -LearnedA/-LearnedB butuh -Weights=<file QNNU> yang valid ('%s')"), *WeightsPath);
+            return 1;
+        }
+        Network = Loaded;
+    }
+    Concurrency = FMath::Clamp(Concurrency, 1, NumGames);
+
+    // Setiap lane sudah memakai satu core dari ParallelFor luar; ParallelFor algoritma 2/4 di dalamnya
+    // dibatasi ke bagian lane itu supaya think time tidak mengukur kontensi antar lane
+    if (SearchThreads <= 0)
+    {
+        SearchThreads = FMath::Max(1, FPlatformMisc::NumberOfCoresIncludingHyperthreads() / Concurrency);
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("QuoridorSelfPlay: %d games, A=(Algo %d, Depth %d, Learned %d, BoardControl %d, SingleSided %d) vs B=(Algo %d, Depth %d, Learned %d, BoardControl %d, SingleSided %d), Seed=%d, Concurrency=%d, SearchThreads=%d"),
+        NumGames, Configs[0].Algorithm, Configs[0].Depth, Configs[0].bLearnedEvaluator ? 1 : 0, Configs[0].bBoardControl ? 1 : 0, Configs[0].bSingleSided ? 1 : 0,
+        Configs[1].Algorithm, Configs[1].Depth, Configs[1].bLearnedEvaluator ? 1 : 0, Configs[1].bBoardControl ? 1 : 0, Configs[1].bSingleSided ? 1 : 0, Seed, Concurrency, SearchThreads);
+
+    TArray<FSelfPlayGame> Games;
+    Games.SetNum(NumGames);
+    for (int32 g = 0; g < NumGames; ++g)
+    {
+        Games[g].GameIndex = g;
+        Games[g].Seed = Seed + g;
+        Games[g].PlayerOfA = (g % 2 == 0) ? 1 : 2;
+    }
+
+    // Concurrency lane, masing-masing memainkan game g, g + Concurrency, ... secara berurutan
+    TAtomic<int32> Finished(0);
+    const double RunStart = FPlatformTime::Seconds();
+    ParallelFor(Concurrency, [&](int32 Lane)
+    {
+        for (int32 g = Lane; g < NumGames; g += Concurrency)
+        {
+            PlaySelfPlayGame(Games[g], Configs, MaxPlies, TTSizeMB, Network, SearchThreads);
+            const int32 Done = ++Finished;
+            UE_LOG(LogTemp, Display, TEXT("QuoridorSelfPlay: game %d/%d selesai (seed %d, winner %d, %d plies)"),
+                Done, NumGames, Games[g].Seed, Games[g].Winner, Games[g].Plies);
+        }
+    });
+    const double RunSeconds = FPlatformTime::Seconds() - RunStart;
+
+    // Per-game CSV
+    FString Csv = TEXT("game,seed,a_player,winner,winner_config,plies,end_reason,think_a,think_b,p1_walls_l1,p1_walls_l2,p1_walls_l3,p2_walls_l1,p2_walls_l2,p2_walls_l3\n");
+    int32 Wins[2] = { 0, 0 };
+    int32 Draws = 0;
+    TArray<double> AllMoveTimes[2];
+    double TotalThink[2] = { 0.0, 0.0 };
+    int32 TotalPlies = 0;
+    for (const FSelfPlayGame& Game : Games)
+    {
+        const TCHAR* WinnerConfig = TEXT("draw");
+        if (Game.Winner != 0)
+        {
+            const int32 Side = (Game.Winner == Game.PlayerOfA) ? 0 : 1;
+            ++Wins[Side];
+            WinnerConfig = (Side == 0) ? TEXT("A") : TEXT("B");
+        }
+        else
+        {
+            ++Draws;
+        }
+
+        for (int32 Side = 0; Side < 2; ++Side)
+        {
+            TotalThink[Side] += Game.ThinkTime[Side];
+            AllMoveTimes[Side].Append(Game.MoveTimes[Side]);
+        }
+        TotalPlies += Game.Plies;
+
+        Csv += FString::Printf(TEXT("%d,%d,%d,%d,%s,%d,%s,%.4f,%.4f,%d,%d,%d,%d,%d,%d\n"),
+            Game.GameIndex, Game.Seed, Game.PlayerOfA, Game.Winner, WinnerConfig, Game.Plies, *Game.EndReason,
+            Game.ThinkTime[0], Game.ThinkTime[1],
+            Game.WallCounts[0][0], Game.WallCounts[0][1], Game.WallCounts[0][2],
+            Game.WallCounts[1][0], Game.WallCounts[1][1], Game.WallCounts[1][2]);
+    }
+
+    // Agregat: win rate A dihitung dengan seri = setengah poin
+    const double ScoreA = (Wins[0] + 0.5 * Draws) / NumGames;
+    FString Summary = TEXT("{\n");
+    Summary += FString::Printf(TEXT("  \"games\": %d,\n  \"seed\": %d,\n  \"max_plies\": %d,\n  \"concurrency\": %d,\n  \"search_threads\": %d,\n"),
+        NumGames, Seed, MaxPlies, Concurrency, SearchThreads);
+    Summary += FString::Printf(TEXT("  \"wall_seconds\": %.3f,\n  \"games_per_hour\": %.1f,\n  \"avg_plies\": %.2f,\n"),
+        RunSeconds, RunSeconds > 0.0 ? NumGames * 3600.0 / RunSeconds : 0.0, static_cast<double>(TotalPlies) / NumGames);
+    Summary += FString::Printf(TEXT("  \"weights\": \"%s\",\n"), *WeightsPath.Replace(TEXT("\\"), TEXT("/")));
+    Summary += FString::Printf(TEXT("  \"wins_a\": %d,\n  \"wins_b\": %d,\n  \"draws\": %d,\n  \"score_a\": %.4f,\n"), Wins[0], Wins[1], Draws, ScoreA);
+    const TCHAR* Names[2] = { TEXT("a"), TEXT("b") };
+    for (int32 Side = 0; Side < 2; ++Side)
+    {
+        const int32 Moves = AllMoveTimes[Side].Num();
+        Summary += FString::Printf(
+            TEXT("  \"%s\": { \"algorithm\": %d, \"depth\": %d, \"learned_evaluator\": %s, \"board_control\": %s, \"single_sided\": %s, \"moves\": %d, \"think_total\": %.4f, \"think_mean\": %.5f, \"think_p50\": %.5f, \"think_p95\": %.5f, \"think_max\": %.5f }%s\n"),
+            Names[Side], Configs[Side].Algorithm, Configs[Side].Depth,
+            Configs[Side].bLearnedEvaluator ? TEXT("true") : TEXT("false"),
+            Configs[Side].bBoardControl ? TEXT("true") : TEXT("false"),
+            Configs[Side].bSingleSided ? TEXT("true") : TEXT("false"), Moves, TotalThink[Side],
+            Moves > 0 ? TotalThink[Side] / Moves : 0.0,
+            Percentile(AllMoveTimes[Side], 0.5), Percentile(AllMoveTimes[Side], 0.95), Percentile(AllMoveTimes[Side], 1.0),
+            Side == 0 ? TEXT(",") : TEXT(""));
+    }
+    Summary += TEXT("}\n");
+
+    const FString SummaryPath = FPaths::ChangeExtension(OutPath, TEXT("summary.json"));
+    if (!FFileHelper::SaveStringToFile(Csv, *OutPath) || !FFileHelper::SaveStringToFile(Summary, *SummaryPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("QuoridorSelfPlay: Gagal menulis %s / %s"), *OutPath, *SummaryPath);
+        return 1;
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("QuoridorSelfPlay: A %d - B %d (draws %d), score A %.3f, %.1f s. Results: %s"),
+        Wins[0], Wins[1], Draws, ScoreA, RunSeconds, *OutPath);
+    return 0;
+}
@@ -0,0 +1,33 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "QuoridorSelfPlayCommandlet.generated.h"
+
+/**
+ * Headless self-play tournament between two engine configurations, played purely on FMinimaxState.
+ *
+ *   UnrealEditor-Cmd Quoridor.uproject -run=QuoridorSelfPlay -nullrhi -unattended
+ *       -Games=200 -AlgoA=3 -DepthA=3 -AlgoB=4 -DepthB=3 -Seed=1 -MaxPlies=200 -Concurrency=8 -TTMB=4
+ *       -Out=Saved/SelfPlay/run.csv
+ *       [-Weights=Bench/net.qnnu -LearnedA=true] [-BoardControlA=true] [-SingleSidedB=false]
+ *
+ * Konfigurasi A main sebagai Player 1 di game genap dan Player 2 di game ganjil. Inventory wall
+ * (10 wall, panjang acak 1-3 seperti SpawnPawn) diacak deterministik dari Seed + index game.
+ * Setiap game memakai dua MinimaxEngine sendiri (TT -TTMB megabyte per engine).
+ * -SearchThreads membatasi thread per search (algoritma 2/4); default core / Concurrency, minimal 1.
+ * -LearnedA / -LearnedB: konfigurasi itu memakai learned evaluator dari -Weights sebagai ganti Evaluate.
+ * -BoardControlA / -BoardControlB: konfigurasi itu menambah term kontrol papan (bUseBoardControlTerm) ke Evaluate.
+ * -SingleSidedA / -SingleSidedB (default true): bEnableSingleSidedSearch engine konfigurasi itu.
+ * Hasil per game ditulis ke CSV, agregat (win rate, think time) ke <Out>.summary.json.
+ */
+UCLASS()
+class QUORIDOR_API UQuoridorSelfPlayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UQuoridorSelfPlayCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -22,18 +22,8 @@ AQuoridorPawn::AQuoridorPawn()
 }
 AQuoridorPawn* ATile::GetOccupyingPawn() const
 {
-	TArray<AActor*> OverlappingActors;
-	GetOverlappingActors(OverlappingActors, AQuoridorPawn::StaticClass());
-
-	for (AActor* Actor : OverlappingActors)
-	{
-		if (AQuoridorPawn* Pawn = Cast<AQuoridorPawn>(Actor))
-		{
-			return Pawn;
-		}
-	}
-
-	return nullptr;
+	// PawnOnTile di-update oleh InitializePawn / MoveToTile / MovePawn, jadi tidak perlu overlap query
+	return PawnOnTile;
 }
 
 void AQuoridorPawn::MoveToTile(ATile* NewTile, bool bForceMove)
@@ -49,6 +39,11 @@ void AQuoridorPawn::MoveToTile(ATile* NewTile, bool bForceMove)
 		CurrentTile->SetPawnOnTile(this);
 		SetActorLocation(CurrentTile->GetActorLocation() + FVector(0, 0, 50));
 
+		if (BoardReference)
+		{
+			BoardReference->ApplyPawnMoveToModel(PlayerNumber, CurrentTile->GridX, CurrentTile->GridY);
+		}
+
 		UE_LOG(LogTemp, Warning, TEXT("Moved pawn to tile (%d, %d)"), CurrentTile->GridX, CurrentTile->GridY);
 
 		// Cek kemenangan
@@ -75,20 +70,10 @@ bool AQuoridorPawn::CanMoveToTile(const ATile* TargetTile) const
 		return false;
 	}
 
-	// Langkah 2: Buat "snapshot" dari kondisi papan permainan saat ini
-	// Fungsi ini harus ada di struct FMinimaxState Anda untuk mengonversi board nyata ke state AI.
-	const FMinimaxState CurrentState = FMinimaxState::FromBoard(BoardReference);
-
-	// Langkah 3: Dapatkan SEMUA kemungkinan gerakan yang sah untuk pion ini dari MinimaxEngine
-	// Engine akan menangani semua aturan rumit (lompatan, blokade tembok, dll.)
-	const TArray<FIntPoint> PossibleMoves = MinimaxEngine::GetPawnMoves(CurrentState, this->PlayerNumber);
-
-	// Langkah 4: Buat FIntPoint untuk tile yang ingin kita tuju
+	// Langkah 2: Tanyakan ke board; langkah legal pemain yang sedang giliran sudah di-cache
+	// sekali per giliran (MinimaxEngine::GetPawnMoves pada BoardModel), jadi klik berulang murah.
 	const FIntPoint TargetCoords(TargetTile->GridX, TargetTile->GridY);
-
-	// Langkah 5: Periksa apakah koordinat target ada di dalam daftar gerakan yang memungkinkan
-	// Fungsi TArray::Contains() akan melakukan semua pekerjaan untuk kita.
-	const bool bIsMoveValid = PossibleMoves.Contains(TargetCoords);
+	const bool bIsMoveValid = BoardReference->IsLegalPawnMove(PlayerNumber, TargetCoords.X, TargetCoords.Y);
 
 	// (Opsional tapi membantu) Tambahkan log untuk melihat hasilnya
 	if (bIsMoveValid)
@@ -120,42 +105,48 @@ void AQuoridorPawn::InitializePawn(ATile* StartTile, AQuoridorBoard* Board)
 
 bool AQuoridorPawn::HasWallOfLength(int32 Length) const
 {
-	for (const FWallDefinition& Wall : PlayerWalls)
-	{
-		if (Wall.Length == Length)
-			return true;
-	}
-	return false;
+	return GetWallCountOfLength(Length) > 0;
 }
 
 int32 AQuoridorPawn::GetWallCountOfLength(int32 Length) const
 {
-	int32 Count = 0;
+	return (Length >= 1 && Length <= 3) ? WallCountByLength[Length - 1] : 0;
+}
+int32 AQuoridorPawn::GetTotalWallCount() const
+{
+	
+	return WallCountByLength[0] + WallCountByLength[1] + WallCountByLength[2]; 
+}
+void AQuoridorPawn::SetPlayerWalls(const TArray<FWallDefinition>& NewWalls)
+{
+	PlayerWalls = NewWalls;
+
+	WallCountByLength[0] = WallCountByLength[1] = WallCountByLength[2] = 0;
 	for (const FWallDefinition& Wall : PlayerWalls)
 	{
-		if (Wall.Length == Length)
+		if (Wall.Length >= 1 && Wall.Length <= 3)
 		{
-			Count++;
+			WallCountByLength[Wall.Length - 1]++;
 		}
 	}
-	return Count;
-}
-int32 AQuoridorPawn::GetTotalWallCount() const
-{
-	
-	return GetWallCountOfLength(1)+GetWallCountOfLength(2) + GetWallCountOfLength(3); 
 }
 bool AQuoridorPawn::RemoveWallOfLength(int32 Length)
 {
+	if (GetWallCountOfLength(Length) == 0)
+	{
+		return false; // Tidak ada wall yang cocok
+	}
+
 	for (int32 i = 0; i < PlayerWalls.Num(); ++i)
 	{
 		if (PlayerWalls[i].Length == Length)
 		{
 			PlayerWalls.RemoveAt(i);
+			WallCountByLength[Length - 1]--;
 			return true;
 		}
 	}
-	return false; // Tidak ada wall yang cocok
+	return false;
 }
 
 void AQuoridorPawn::SetGridPosition(int32 X, int32 Y)
@@ -206,6 +197,7 @@ void AQuoridorPawn::MovePawn(int32 NewX, int32 NewY)
             CurrentTile = TargetTile;
             CurrentTile->SetPawnOnTile(this);
             SetActorLocation(CurrentTile->GetActorLocation() + FVector(0, 0, 50));
+            BoardReference->ApplyPawnMoveToModel(PlayerNumber, NewX, NewY);
 
             UE_LOG(LogTemp, Warning, TEXT("MovePawn Success: Player %d moved to (%d, %d)"), PlayerNumber, NewX, NewY)
 
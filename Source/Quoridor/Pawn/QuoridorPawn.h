@@ -62,6 +62,9 @@ public:
 	UPROPERTY(BlueprintReadOnly)
 	TArray<FWallDefinition> PlayerWalls;
 
+	/** Mengganti inventory wall sekaligus menghitung ulang WallCountByLength */
+	void SetPlayerWalls(const TArray<FWallDefinition>& NewWalls);
+
 	UFUNCTION(BlueprintCallable)
 	bool HasRemainingWalls() const { return PlayerWalls.Num() > 0; }
 	
@@ -91,4 +94,7 @@ protected:
 
 	UPROPERTY(VisibleAnywhere)
 	class UBoxComponent* SelectionCollision;
+
+	// Jumlah wall per panjang [Length - 1], selalu sinkron dengan PlayerWalls
+	int32 WallCountByLength[3] = { 0, 0, 0 };
 };
\ No newline at end of file
@@ -41,3 +41,11 @@ void ATile::ClearConnections()
 {
 	ConnectedTiles.Empty();
 }
+
+void ATile::SetVisualMeshHidden(bool bHidden)
+{
+	if (TileMesh)
+	{
+		TileMesh->SetHiddenInGame(bHidden);
+	}
+}
@@ -23,10 +23,11 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void SetGridPosition(int32 X, int32 Y) { GridX = X; GridY = Y; }
 
+	/** O(1): dijawab dari PawnOnTile, bukan dari overlap query */
 	::AQuoridorPawn* GetOccupyingPawn() const;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-	AQuoridorPawn* PawnOnTile;
+	AQuoridorPawn* PawnOnTile = nullptr;
 
 	UFUNCTION(BlueprintCallable)
 	bool IsOccupied() const { return PawnOnTile != nullptr; }
@@ -49,6 +50,9 @@ public:
 
 	UFUNCTION()
 	void ClearConnections();
+
+	/** Dipakai saat board menggambar tile lewat instanced mesh; collision tetap aktif untuk klik */
+	void SetVisualMeshHidden(bool bHidden);
 	
 protected:
 	UPROPERTY(VisibleAnywhere)